@@ -7,7 +7,9 @@
 #include <poincare/init.h>
 
 #include "apps_container_storage.h"
+#include "benchmark.h"
 #include "global_preferences.h"
+#include "machine_snapshot.h"
 #include "shared/record_restrictive_extensions_helper.h"
 
 extern "C" {
@@ -31,7 +33,8 @@ AppsContainer::AppsContainer()
                          k_promptNumberOfMessages)
 #if EPSILON_GETOPT
       ,
-      m_initialAppSnapshot(nullptr)
+      m_initialAppSnapshot(nullptr),
+      m_machineSnapshotFilename(nullptr)
 #endif
 {
   m_emptyBatteryWindow.setAbsoluteFrame(KDRectScreen);
@@ -133,6 +136,9 @@ bool AppsContainer::dispatchEvent(Ion::Events::Event event) {
     Ion::Clipboard::fetchSystemClipboardToBuffer();
   }
 
+#if ION_SIMULATOR_FILES
+  Benchmark::EventWillDispatch(event, window());
+#endif
   bool didProcessEvent = Container::dispatchEvent(event);
 
   if (!didProcessEvent) {
@@ -152,8 +158,11 @@ bool AppsContainer::dispatchEvent(Ion::Events::Event event) {
   }
   if (!didProcessEvent && alphaLockWantsRedraw) {
     window()->redraw();
-    return true;
+    didProcessEvent = true;
   }
+#if ION_SIMULATOR_FILES
+  Benchmark::EventDidDispatch();
+#endif
   return didProcessEvent || alphaLockWantsRedraw;
 }
 
@@ -287,6 +296,9 @@ void AppsContainer::run() {
     homeInterruptOcurred = false;
   } else {
     homeInterruptOcurred = true;
+#if ION_SIMULATOR_FILES
+    Benchmark::DispatchWasInterrupted();
+#endif
   }
 
   ExceptionCheckpoint exceptionCheckpoint;
@@ -317,6 +329,9 @@ void AppsContainer::run() {
      * is then asserted empty). This prevents from allocating new handles
      * with the same identifiers as potential dangling handles (that have
      * lost their nodes in the exception). */
+#if ION_SIMULATOR_FILES
+    Benchmark::DispatchWasInterrupted();
+#endif
     TreePool::Lock();
     handleRunException();
     TreePool::Unlock();
@@ -324,7 +339,22 @@ void AppsContainer::run() {
   }
 
   Container::run();
+#if EPSILON_GETOPT && ION_SIMULATOR_FILES
+  int activeAppIndex = MachineSnapshot::k_noApp;
+  for (int i = 0; i < numberOfBuiltinApps(); i++) {
+    if (activeApp() && appSnapshotAtIndex(i) == activeApp()->snapshot()) {
+      activeAppIndex = i;
+    }
+  }
+#endif
   switchToBuiltinApp(nullptr);
+#if EPSILON_GETOPT && ION_SIMULATOR_FILES
+  // Save the state once the active app has been packed into its snapshot
+  if (m_machineSnapshotFilename &&
+      !MachineSnapshot::Save(m_machineSnapshotFilename, activeAppIndex)) {
+    Ion::Console::writeLine("Error saving the machine snapshot");
+  }
+#endif
 }
 
 bool AppsContainer::updateBatteryState() {
@@ -27,6 +27,11 @@ class AppsContainer : public Escher::Container, Ion::Storage::StorageDelegate {
   int numberOfApps() { return numberOfExternalApps() + numberOfBuiltinApps(); }
   int numberOfExternalApps() { return Ion::ExternalApps::numberOfApps(); }
   virtual Escher::App::Snapshot* appSnapshotAtIndex(int index) = 0;
+#if ION_SIMULATOR_FILES
+  // Bytes of the snapshot of a builtin app, saved as they are by the simulator
+  virtual void appSnapshotBytesAtIndex(int index, void** address,
+                                       size_t* size) = 0;
+#endif
   Ion::ExternalApps::App externalAppAtIndex(int index);
   Escher::App::Snapshot* initialAppSnapshot();
   Escher::App::Snapshot* hardwareTestAppSnapshot();
@@ -61,6 +66,9 @@ class AppsContainer : public Escher::Container, Ion::Storage::StorageDelegate {
   void setInitialAppSnapshot(Escher::App::Snapshot* snapshot) {
     m_initialAppSnapshot = snapshot;
   }
+  void setMachineSnapshotFilename(const char* filename) {
+    m_machineSnapshotFilename = filename;
+  }
 #endif
 
  private:
@@ -96,6 +104,8 @@ class AppsContainer : public Escher::Container, Ion::Storage::StorageDelegate {
 #if EPSILON_GETOPT
   // Used to launch a given app on a simulator
   Escher::App::Snapshot* m_initialAppSnapshot;
+  // Where the simulator saves its state when the run loop terminates
+  const char* m_machineSnapshotFilename;
 #endif
 };
 
@@ -41,6 +41,24 @@ Escher::App::Snapshot* AppsContainerStorage::appSnapshotAtIndex(int index) {
   return snapshots[index];
 }
 
+#if ION_SIMULATOR_FILES
+template <typename... T>
+static void SnapshotBytes(int index, void** address, size_t* size,
+                          T*... snapshots) {
+  void* addresses[] = {snapshots...};
+  size_t sizes[] = {sizeof(T)...};
+  *address = addresses[index];
+  *size = sizes[index];
+}
+
+void AppsContainerStorage::appSnapshotBytesAtIndex(int index, void** address,
+                                                   size_t* size) {
+  assert(index >= 0 && index < numberOfBuiltinApps());
+  SnapshotBytes(index, address, size,
+                homeAppSnapshot() APPS_CONTAINER_SNAPSHOT_LIST);
+}
+#endif
+
 union Apps {
  public:
   /* Enforce a trivial constructor and destructor that just leave the memory
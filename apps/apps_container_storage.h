@@ -16,6 +16,10 @@ class AppsContainerStorage : public AppsContainer {
   int numberOfBuiltinApps() override;
   Escher::App::Snapshot* appSnapshotAtIndex(int index) override;
   void* currentAppBuffer() override;
+#if ION_SIMULATOR_FILES
+  void appSnapshotBytesAtIndex(int index, void** address,
+                               size_t* size) override;
+#endif
 
  private:
   APPS_CONTAINER_SNAPSHOT_DECLARATIONS
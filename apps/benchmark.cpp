@@ -0,0 +1,185 @@
+#include "benchmark.h"
+
+#if ION_SIMULATOR_FILES
+
+#include <assert.h>
+#include <kandinsky/ion_context.h>
+#include <poincare/tree_pool.h>
+#include <python/port/port.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+
+using Poincare::TreePool;
+
+struct Measure {
+  int64_t dispatchDuration;
+  int numberOfRedraws;
+  int64_t redrawDuration;
+  int numberOfPushedRects;
+  int64_t numberOfPushedPixels;
+  int64_t poolPeakSize;
+  int64_t pythonHeapSize;
+};
+
+struct Counters {
+  int numberOfRedraws;
+  int64_t redrawDuration;
+  int numberOfPushedRects;
+  int64_t numberOfPushedPixels;
+};
+
+static FILE* sReport = nullptr;
+static bool sReportWasCreated = false;
+static const char* sScenarioName;
+static int sNumberOfEvents;
+static int sDispatchDepth;
+static Ion::Events::Event sEvent;
+static const Escher::Window* sWindow;
+static std::chrono::steady_clock::time_point sDispatchStart;
+static Counters sCountersBeforeDispatch;
+static Measure sTotal;
+
+static Counters CurrentCounters(const Escher::Window* window) {
+  Counters counters = {0, 0, 0, 0};
+#if ESCHER_REDRAW_TELEMETRY
+  counters.numberOfRedraws = window->telemetry().numberOfRedraws;
+  counters.redrawDuration = window->telemetry().redrawDuration;
+#endif
+#if KANDINSKY_DISPLAY_TELEMETRY
+  const KDIonContext::Telemetry& telemetry =
+      KDIonContext::SharedContext->telemetry();
+  counters.numberOfPushedRects = telemetry.numberOfPushedRects;
+  counters.numberOfPushedPixels = telemetry.numberOfPushedPixels;
+#endif
+  return counters;
+}
+
+// Scenario paths may contain quotes, backslashes or control characters
+static void WriteJSONString(const char* string) {
+  fputc('"', sReport);
+  for (const char* c = string; *c != 0; c++) {
+    if (*c == '"' || *c == '\\') {
+      fputc('\\', sReport);
+      fputc(*c, sReport);
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      fprintf(sReport, "\\u%04x", static_cast<unsigned char>(*c));
+    } else {
+      fputc(*c, sReport);
+    }
+  }
+  fputc('"', sReport);
+}
+
+static void WriteMeasure(const char* position, const Measure& measure) {
+  fputs("{\"scenario\": ", sReport);
+  WriteJSONString(sScenarioName);
+  fprintf(sReport,
+          ", %s, \"dispatch_us\": %lld, "
+          "\"redraws\": %d, \"redraw_us\": %lld, \"pushed_rects\": %d, "
+          "\"pushed_pixels\": %lld, \"pool_peak_bytes\": %lld, "
+          "\"python_heap_bytes\": %lld}\n",
+          position, static_cast<long long>(measure.dispatchDuration),
+          measure.numberOfRedraws,
+          static_cast<long long>(measure.redrawDuration),
+          measure.numberOfPushedRects,
+          static_cast<long long>(measure.numberOfPushedPixels),
+          static_cast<long long>(measure.poolPeakSize),
+          static_cast<long long>(measure.pythonHeapSize));
+}
+
+bool Benchmark::Start(const char* reportPath, const char* scenarioName) {
+  assert(sReport == nullptr);
+  sReport = fopen(reportPath, sReportWasCreated ? "a" : "w");
+  if (sReport == nullptr) {
+    return false;
+  }
+  sReportWasCreated = true;
+  sScenarioName = scenarioName;
+  sNumberOfEvents = 0;
+  sDispatchDepth = 0;
+  sTotal = {0, 0, 0, 0, 0, 0, 0};
+  return true;
+}
+
+void Benchmark::Stop() {
+  if (sReport == nullptr) {
+    return;
+  }
+  char position[32];
+  snprintf(position, sizeof(position), "\"events\": %d", sNumberOfEvents);
+  WriteMeasure(position, sTotal);
+  fclose(sReport);
+  sReport = nullptr;
+}
+
+void Benchmark::EventWillDispatch(Ion::Events::Event event,
+                                  const Escher::Window* window) {
+  if (sReport == nullptr || sDispatchDepth++ > 0) {
+    return;
+  }
+  sEvent = event;
+  sWindow = window;
+  sCountersBeforeDispatch = CurrentCounters(window);
+#if POINCARE_POOL_TELEMETRY
+  // The Python heap takes over the pool memory while MicroPython is running
+  if (!MicroPython::isInitialized()) {
+    TreePool::sharedPool->resetPeakSize();
+  }
+#endif
+  sDispatchStart = std::chrono::steady_clock::now();
+}
+
+void Benchmark::EventDidDispatch() {
+  if (sReport == nullptr || --sDispatchDepth > 0) {
+    return;
+  }
+  Measure measure;
+  measure.dispatchDuration =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - sDispatchStart)
+          .count();
+  Counters counters = CurrentCounters(sWindow);
+  measure.numberOfRedraws =
+      counters.numberOfRedraws - sCountersBeforeDispatch.numberOfRedraws;
+  measure.redrawDuration =
+      counters.redrawDuration - sCountersBeforeDispatch.redrawDuration;
+  measure.numberOfPushedRects = counters.numberOfPushedRects -
+                                sCountersBeforeDispatch.numberOfPushedRects;
+  measure.numberOfPushedPixels = counters.numberOfPushedPixels -
+                                 sCountersBeforeDispatch.numberOfPushedPixels;
+  bool pythonIsInitialized = MicroPython::isInitialized();
+  measure.poolPeakSize = 0;
+#if POINCARE_POOL_TELEMETRY
+  if (!pythonIsInitialized) {
+    measure.poolPeakSize = TreePool::sharedPool->telemetry().peakSize;
+  }
+#endif
+  measure.pythonHeapSize =
+      pythonIsInitialized ? MicroPython::usedHeapSize() : 0;
+
+  char position[48];
+  snprintf(position, sizeof(position), "\"index\": %d, \"event\": %d",
+           sNumberOfEvents, static_cast<uint8_t>(sEvent));
+  WriteMeasure(position, measure);
+
+  sNumberOfEvents++;
+  sTotal.dispatchDuration += measure.dispatchDuration;
+  sTotal.numberOfRedraws += measure.numberOfRedraws;
+  sTotal.redrawDuration += measure.redrawDuration;
+  sTotal.numberOfPushedRects += measure.numberOfPushedRects;
+  sTotal.numberOfPushedPixels += measure.numberOfPushedPixels;
+  sTotal.poolPeakSize = std::max(sTotal.poolPeakSize, measure.poolPeakSize);
+  sTotal.pythonHeapSize =
+      std::max(sTotal.pythonHeapSize, measure.pythonHeapSize);
+}
+
+void Benchmark::DispatchWasInterrupted() {
+  if (sDispatchDepth > 0) {
+    sDispatchDepth = 1;
+    EventDidDispatch();
+  }
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef APPS_BENCHMARK_H
+#define APPS_BENCHMARK_H
+
+#if ION_SIMULATOR_FILES
+
+#include <escher/window.h>
+#include <ion/events.h>
+
+/* The benchmark reports the cost of each event a simulator run dispatches, so
+ * that the reports of two builds replaying the same scenarios can be diffed.
+ * Each event appends a JSON object on its own line to the report (wrapped
+ * here):
+ *   {"scenario": "calculation.nws", "index": 3, "event": 4,
+ *    "dispatch_us": 1520, "redraws": 1, "redraw_us": 1210,
+ *    "pushed_rects": 87, "pushed_pixels": 41230, "pool_peak_bytes": 512,
+ *    "python_heap_bytes": 0}
+ * The event is its Ion::Events::Event id. Each scenario ends with a line where
+ * "events" counts them, with the sums of their fields and the highest pool and
+ * heap usages. Only the outermost dispatch of nested events is measured.
+ * Counters that are not compiled in, as well as the pool peak while MicroPython
+ * borrows the pool memory, are reported as 0.
+ * Durations come from the host clock, the other fields are reproducible. */
+
+class Benchmark {
+ public:
+  /* The report is truncated by the first scenario of the process and appended
+   * to by the next ones, so that a batch of state files fills one report. */
+  static bool Start(const char* reportPath, const char* scenarioName);
+  static void Stop();
+
+  // The window is the one the event is dispatched to
+  static void EventWillDispatch(Ion::Events::Event event,
+                                const Escher::Window* window);
+  static void EventDidDispatch();
+  /* A checkpoint jumped out of the dispatch, the event is reported as if it
+   * was fully dispatched. */
+  static void DispatchWasInterrupted();
+};
+
+#endif
+
+#endif
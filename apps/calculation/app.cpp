@@ -39,7 +39,11 @@ const App::Descriptor *App::Snapshot::descriptor() const {
 }
 
 App::Snapshot::Snapshot()
-    : m_calculationStore(m_calculationBuffer, k_calculationBufferSize) {}
+    : m_calculationStore(m_calculationBuffer, k_calculationBufferSize),
+      m_cacheBuffer(""),
+      m_cacheBufferInformation(0),
+      m_cacheCursorOffset(0),
+      m_cacheCursorPosition(0) {}
 
 App::App(Snapshot *snapshot)
     : MathApp(snapshot, &m_editExpressionController),
@@ -39,6 +39,7 @@ void HistoryController::reload() {
   for (int i = 0; i < k_maxNumberOfDisplayedRows; i++) {
     m_calculationHistory[i].resetMemoization();
   }
+  m_replacedLayouts = HistoryViewCell::CalculationLayouts();
 
   m_selectableListView.reloadData();
   /* TODO
@@ -183,10 +184,24 @@ int HistoryController::reusableCellCount(int type) const {
 void HistoryController::fillCellForRow(HighlightCell *cell, int row) {
   HistoryViewCell *myCell = static_cast<HistoryViewCell *>(cell);
   Poincare::Context *context = App::app()->localContext();
-  myCell->setCalculation(
-      calculationAtIndex(row).pointer(),
-      row == selectedRow() && m_selectedSubviewType == SubviewType::Output,
-      context);
+  Calculation *calculation = calculationAtIndex(row).pointer();
+  bool expanded =
+      row == selectedRow() && m_selectedSubviewType == SubviewType::Output;
+  uint32_t calculationCRC32 = HistoryViewCell::CalculationCRC32(calculation);
+  HistoryViewCell::CalculationLayouts replacedLayouts =
+      myCell->calculationLayouts();
+  if (replacedLayouts.calculationCRC32 != calculationCRC32) {
+    /* Scrolling by a row gives each cell the row of its neighbour: its
+     * layouts are held by another cell, or were replaced in the previous
+     * refilled cell. */
+    const HistoryViewCell::CalculationLayouts *layouts =
+        memoizedLayouts(calculationCRC32);
+    if (layouts) {
+      myCell->setCalculationLayouts(*layouts, expanded);
+    }
+    m_replacedLayouts = replacedLayouts;
+  }
+  myCell->setCalculation(calculation, expanded, context);
   myCell->setEven(row % 2 == 0);
   myCell->reloadSubviewHighlight();
 }
@@ -201,6 +216,23 @@ KDCoordinate HistoryController::nonMemoizedRowHeight(int row) {
   return calculation->height(expanded);
 }
 
+const HistoryViewCell::CalculationLayouts *HistoryController::memoizedLayouts(
+    uint32_t calculationCRC32) const {
+  if (calculationCRC32 == 0) {
+    return nullptr;
+  }
+  for (int i = 0; i < k_maxNumberOfDisplayedRows; i++) {
+    const HistoryViewCell::CalculationLayouts &layouts =
+        m_calculationHistory[i].calculationLayouts();
+    if (layouts.calculationCRC32 == calculationCRC32) {
+      return &layouts;
+    }
+  }
+  return m_replacedLayouts.calculationCRC32 == calculationCRC32
+             ? &m_replacedLayouts
+             : nullptr;
+}
+
 bool HistoryController::calculationAtIndexToggles(int index) const {
   Context *context = App::app()->localContext();
   return index >= 0 && index < m_calculationStore->numberOfCalculations() &&
@@ -45,12 +45,16 @@ class HistoryController : public Escher::ViewController,
   int storeIndex(int i) const { return numberOfRows() - i - 1; }
   Shared::ExpiringPointer<Calculation> calculationAtIndex(int i) const;
   bool calculationAtIndexToggles(int index) const;
+  const HistoryViewCell::CalculationLayouts* memoizedLayouts(
+      uint32_t calculationCRC32) const;
   void handleOK();
 
   constexpr static int k_maxNumberOfDisplayedRows = 6;
 
   CalculationSelectableListView m_selectableListView;
   HistoryViewCell m_calculationHistory[k_maxNumberOfDisplayedRows];
+  // Layouts of the calculation a cell displayed before its last refill
+  HistoryViewCell::CalculationLayouts m_replacedLayouts;
   CalculationStore* m_calculationStore;
   AdditionalResultsController m_additionalResultsController;
 };
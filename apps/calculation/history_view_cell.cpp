@@ -30,9 +30,6 @@ void HistoryViewCell::ComputeCalculationHeights(Calculation *calculation,
 
 HistoryViewCell::HistoryViewCell(Responder *parentResponder)
     : Responder(parentResponder),
-      m_calculationCRC32(0),
-      m_calculationDisplayOutput(Calculation::DisplayOutput::Unknown),
-      m_hasEllipsis(false),
       m_inputView(this, k_inputViewHorizontalMargin,
                   k_inputOutputViewsVerticalMargin),
       m_scrollableOutputView(this),
@@ -107,11 +104,12 @@ void HistoryViewCell::reloadScroll() {
 
 void HistoryViewCell::reloadOutputSelection(
     HistoryViewCellDataSource::SubviewType previousType) {
-  assert(m_calculationDisplayOutput != Calculation::DisplayOutput::Unknown);
+  assert(m_calculationLayouts.displayOutput !=
+         Calculation::DisplayOutput::Unknown);
   /* Select the right output according to the calculation display output. This
    * will reload the scroll to display the selected output. */
   bool selectExactOutput =
-      m_calculationDisplayOutput ==
+      m_calculationLayouts.displayOutput ==
           Calculation::DisplayOutput::ExactAndApproximate &&
       previousType != HistoryViewCellDataSource::SubviewType::Ellipsis;
   m_scrollableOutputView.setSelectedSubviewPosition(
@@ -251,16 +249,21 @@ void HistoryViewCell::resetMemoization() {
    * TODO: maybe do this only when the layout won't change to avoid blinking */
   m_inputView.setLayout(Layout());
   m_scrollableOutputView.resetLayouts();
-  m_calculationCRC32 = 0;
+  m_calculationLayouts = CalculationLayouts();
+}
+
+uint32_t HistoryViewCell::CalculationCRC32(const Calculation *calculation) {
+  return Ion::crc32Byte(
+      reinterpret_cast<const uint8_t *>(calculation),
+      reinterpret_cast<const char *>(calculation->next()) -
+          reinterpret_cast<const char *>(calculation));
 }
 
 void HistoryViewCell::setCalculation(Calculation *calculation, bool expanded,
                                      Context *context,
                                      bool canChangeDisplayOutput) {
-  uint32_t newCalculationCRC =
-      Ion::crc32Byte((const uint8_t *)calculation,
-                     ((char *)calculation->next()) - ((char *)calculation));
-  if (newCalculationCRC == m_calculationCRC32) {
+  uint32_t newCalculationCRC = CalculationCRC32(calculation);
+  if (newCalculationCRC == m_calculationLayouts.calculationCRC32) {
     if (updateExpanded(expanded)) {
       reloadScroll();
     }
@@ -270,53 +273,69 @@ void HistoryViewCell::setCalculation(Calculation *calculation, bool expanded,
   // TODO: maybe do this only when the layout won't change to avoid blinking
   resetMemoization();
 
-  // Memoization
-  m_calculationCRC32 = newCalculationCRC;
-
   setNewCalculation(calculation, expanded, context, canChangeDisplayOutput);
 
+  // Memoization
+  m_calculationLayouts.calculationCRC32 = newCalculationCRC;
+
   /* The displayed input and outputs have changed. We need to re-layout the cell
    * and re-initialize the scroll. */
   layoutSubviews();
   reloadScroll();
 }
 
+void HistoryViewCell::setCalculationLayouts(const CalculationLayouts &layouts,
+                                            bool expanded) {
+  assert(layouts.calculationCRC32 != 0);
+  resetMemoization();
+  m_calculationLayouts = layouts;
+  displayCalculationLayouts(expanded);
+  layoutSubviews();
+  reloadScroll();
+}
+
 void HistoryViewCell::setNewCalculation(Calculation *calculation, bool expanded,
                                         Poincare::Context *context,
                                         bool canChangeDisplayOutput) {
-  // Memoization
-  m_hasEllipsis = calculation->additionalResultsType().isNotEmpty();
-  m_inputView.setLayout(calculation->createInputLayout());
+  CalculationLayouts layouts;
+  layouts.hasEllipsis = calculation->additionalResultsType().isNotEmpty();
+  layouts.input = calculation->createInputLayout();
 
   /* All expressions have to be updated at the same time. Otherwise,
    * when updating one layout, if the second one still points to a deleted
    * layout, calling to layoutSubviews() would fail. */
-  Layout exactOutputLayout, approximateOutputLayout;
   KDFont::Size font = m_scrollableOutputView.font();
   KDCoordinate maxVisibleWidth =
       Ion::Display::Width -
       (m_scrollableOutputView.margins()->width() +
        2 * KDFont::GlyphWidth(font));  // > arrow and = sign
-  calculation->createOutputLayouts(&exactOutputLayout, &approximateOutputLayout,
-                                   context, canChangeDisplayOutput,
-                                   maxVisibleWidth, font);
+  calculation->createOutputLayouts(&layouts.exactOutput,
+                                   &layouts.approximateOutput, context,
+                                   canChangeDisplayOutput, maxVisibleWidth,
+                                   font);
 
-  /* Update m_calculationDisplayOutput. Must be done after createOutputLayouts
+  /* Update the display output. Must be done after createOutputLayouts
    * because calculation->displayOutput can change. */
-  m_calculationDisplayOutput = calculation->displayOutput(context);
+  layouts.displayOutput = calculation->displayOutput(context);
+  layouts.exactAndApproximateAreEqual =
+      calculation->equalSign(context) == Calculation::EqualSign::Equal;
+  m_calculationLayouts = layouts;
+  displayCalculationLayouts(expanded);
+}
 
-  /* Update m_scrollableOutputView. Must be done once m_calculationDisplayOutput
-   * has been updated. We must set which subviews are displayed before
-   * setLayouts to mark the right rectangle as dirty. */
+void HistoryViewCell::displayCalculationLayouts(bool expanded) {
+  m_inputView.setLayout(m_calculationLayouts.input);
+  /* Update m_scrollableOutputView. We must set which subviews are displayed
+   * before setLayouts to mark the right rectangle as dirty. */
   m_scrollableOutputView.setDisplayableCenter(
-      m_calculationDisplayOutput ==
+      m_calculationLayouts.displayOutput ==
           Calculation::DisplayOutput::ExactAndApproximate ||
-      m_calculationDisplayOutput ==
+      m_calculationLayouts.displayOutput ==
           Calculation::DisplayOutput::ExactAndApproximateToggle);
-  m_scrollableOutputView.setLayouts(Layout(), exactOutputLayout,
-                                    approximateOutputLayout);
+  m_scrollableOutputView.setLayouts(Layout(), m_calculationLayouts.exactOutput,
+                                    m_calculationLayouts.approximateOutput);
   m_scrollableOutputView.setExactAndApproximateAreStriclyEqual(
-      calculation->equalSign(context) == Calculation::EqualSign::Equal);
+      m_calculationLayouts.exactAndApproximateAreEqual);
   updateExpanded(expanded);
 }
 
@@ -397,11 +416,12 @@ bool HistoryViewCell::handleEvent(Ion::Events::Event event) {
 }
 
 bool HistoryViewCell::updateExpanded(bool expanded) {
-  assert(m_calculationDisplayOutput != Calculation::DisplayOutput::Unknown);
+  assert(m_calculationLayouts.displayOutput !=
+         Calculation::DisplayOutput::Unknown);
   TrinaryBoolean calculationExpanded = BinaryToTrinaryBool(
-      m_calculationDisplayOutput ==
+      m_calculationLayouts.displayOutput ==
           Calculation::DisplayOutput::ExactAndApproximate ||
-      (expanded && m_calculationDisplayOutput ==
+      (expanded && m_calculationLayouts.displayOutput ==
                        Calculation::DisplayOutput::ExactAndApproximateToggle));
   if (m_calculationExpanded == calculationExpanded) {
     return false;
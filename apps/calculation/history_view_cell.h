@@ -26,6 +26,20 @@ class HistoryViewCellDataSource {
 
 class HistoryViewCell : public Escher::EvenOddCell, public Escher::Responder {
  public:
+  /* What a cell builds to display a calculation. When scrolling, the rows
+   * shift through the cells: the history hands these layouts from a cell to
+   * another instead of parsing the calculation again. */
+  struct CalculationLayouts {
+    uint32_t calculationCRC32 = 0;
+    Poincare::Layout input;
+    Poincare::Layout exactOutput;
+    Poincare::Layout approximateOutput;
+    Calculation::DisplayOutput displayOutput =
+        Calculation::DisplayOutput::Unknown;
+    bool hasEllipsis = false;
+    bool exactAndApproximateAreEqual = false;
+  };
+
   constexpr static KDCoordinate k_margin = Escher::Metric::CommonSmallMargin;
   constexpr static KDCoordinate k_inputOutputViewsVerticalMargin = k_margin;
   constexpr static KDCoordinate k_inputViewHorizontalMargin =
@@ -34,6 +48,7 @@ class HistoryViewCell : public Escher::EvenOddCell, public Escher::Responder {
 
   static void ComputeCalculationHeights(Calculation* calculation,
                                         Poincare::Context* context);
+  static uint32_t CalculationCRC32(const Calculation* calculation);
   HistoryViewCell(Responder* parentResponder = nullptr);
   static bool ViewsCanBeSingleLine(KDCoordinate inputViewWidth,
                                    KDCoordinate outputViewWidth, bool ellipsis);
@@ -60,6 +75,11 @@ class HistoryViewCell : public Escher::EvenOddCell, public Escher::Responder {
   void setNewCalculation(Calculation* calculation, bool expanded,
                          Poincare::Context* context,
                          bool canChangeDisplayOutput = false);
+  const CalculationLayouts& calculationLayouts() const {
+    return m_calculationLayouts;
+  }
+  // Display layouts built by another cell for the same calculation
+  void setCalculationLayouts(const CalculationLayouts& layouts, bool expanded);
   int numberOfSubviews() const override { return 2 + isDisplayingEllipsis(); }
   View* subviewAtIndex(int index) override;
   void layoutSubviews(bool force = false) override;
@@ -69,7 +89,7 @@ class HistoryViewCell : public Escher::EvenOddCell, public Escher::Responder {
     return &m_scrollableOutputView;
   }
   Escher::ScrollableLayoutView* inputView() { return &m_inputView; }
-  bool hasEllipsis() const { return m_hasEllipsis; }
+  bool hasEllipsis() const { return m_calculationLayouts.hasEllipsis; }
   KDCoordinate minimalHeightForOptimalDisplay();
 
  private:
@@ -90,9 +110,8 @@ class HistoryViewCell : public Escher::EvenOddCell, public Escher::Responder {
   void reloadOutputSelection(
       HistoryViewCellDataSource::SubviewType previousType);
   bool isDisplayingEllipsis() const { return isHighlighted() && hasEllipsis(); }
-  uint32_t m_calculationCRC32;
-  Calculation::DisplayOutput m_calculationDisplayOutput;
-  bool m_hasEllipsis;
+  void displayCalculationLayouts(bool expanded);
+  CalculationLayouts m_calculationLayouts;
   Escher::ScrollableLayoutView m_inputView;
   Escher::ScrollableTwoLayoutsView m_scrollableOutputView;
   Escher::EvenOddCellWithEllipsis m_ellipsis;
@@ -81,6 +81,7 @@ App::App(Snapshot *snapshot)
           Escher::StackViewController::Style::WhiteUniform),
       m_variableBox() {
   Clipboard::sharedClipboard()->enterPython();
+  ScriptStore::DeleteCompiledScripts();
 }
 
 bool App::quitInputRunLoop() {
@@ -97,6 +98,7 @@ App::~App() {
   quitInputRunLoop();
   deinitPython();
   Clipboard::sharedClipboard()->exitPython();
+  ScriptStore::DeleteCompiledScripts();
 }
 
 bool App::handleEvent(Ion::Events::Event event) {
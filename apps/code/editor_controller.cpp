@@ -37,6 +37,8 @@ void EditorController::setScript(Script script, int scriptIndex) {
    *
    * */
 
+  // The edits would outdate the compiled script anyway
+  ScriptStore::DeleteCompiledScript(m_script);
   Ion::Storage::FileSystem::sharedFileSystem->putAvailableSpaceAtEndOfRecord(
       m_script);
   m_editorView.setText(const_cast<char *>(m_script.content()),
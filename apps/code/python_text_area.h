@@ -3,6 +3,8 @@
 
 #include <escher/text_area.h>
 
+struct _mp_lexer_t;
+
 namespace Code {
 
 class App;
@@ -51,7 +53,13 @@ class PythonTextArea : public Escher::TextArea {
         : Escher::TextArea::ContentView(font),
           m_pythonDelegate(pythonDelegate),
           m_autocomplete(false),
-          m_autocompletionEnd(nullptr) {}
+          m_autocompletionEnd(nullptr),
+          m_numberOfValidLineStates(1) {
+      m_lineStates[0] = LineState::Code;
+      for (CachedLine& cachedLine : m_cachedLines) {
+        cachedLine.line = -1;
+      }
+    }
     App* pythonDelegate() { return m_pythonDelegate; }
     void setAutocompleting(bool autocomplete) { m_autocomplete = autocomplete; }
     bool isAutocompleting() const { return m_autocomplete; }
@@ -69,14 +77,72 @@ class PythonTextArea : public Escher::TextArea {
                   const char* selectionEnd) const override;
     KDRect dirtyRectFromPosition(const char* position,
                                  bool includeFollowingLines) const override;
+    /* Color of the code point at position, as drawLine colors it, going
+     * through the same highlighting cache. */
+    KDColor colorAtPosition(const char* position) const;
+
+   protected:
+    void textDidChangeFromPosition(const char* position) override;
 
    private:
+    /* Lexing every drawn line on each redraw is slow in long scripts, so the
+     * highlighting is cached: the state at the start of each line, which
+     * depends on all the lines above, and the colored runs of the last drawn
+     * lines. Edits invalidate both from the edited line onwards. */
+    constexpr static int k_maxNumberOfLineStates = 1000;
+    constexpr static int k_numberOfCachedLines = 16;
+    constexpr static int k_maxNumberOfRuns = 24;
+
+    enum class LineState : uint8_t {
+      Code,
+      // Inside a string opened by ''' or """ on a line above
+      SingleQuotedString,
+      DoubleQuotedString
+    };
+    // A run ends where the next one starts, the first one at the line start
+    struct Run {
+      uint16_t end;  // Offset from the line start
+      KDColor color;
+    };
+    struct CachedLine {
+      int line;  // -1 if unused
+      uint8_t numberOfRuns;
+      Run runs[k_maxNumberOfRuns];
+    };
+
+    /* Scans the strings of text until end, which is a line end. Tells where
+     * the code starts after a string continued from the lines above, where it
+     * ends before a string continued on the lines below, and returns the state
+     * of the next line. */
+    static LineState ScanLine(const char* text, const char* end,
+                              LineState state, const char** codeStart,
+                              const char** codeEnd);
+    LineState lineStateAt(int line, const char* lineText) const;
+    /* Colors text from from, a token boundary, until end. Returns where it
+     * stopped once there are k_maxNumberOfRuns runs. */
+    const char* computeRuns(const char* text, const char* from,
+                            const char* end, LineState state, Run* runs,
+                            int* numberOfRuns) const;
+    /* Calls runsAction(from, runs, numberOfRuns) on the runs coloring the
+     * line, in order, from the cache when possible. */
+    template <typename T>
+    void colorLine(int line, const char* text, size_t byteLength,
+                   T runsAction) const;
+    void drawRuns(KDContext* ctx, int line, const char* text,
+                  const char* from, const Run* runs, int numberOfRuns,
+                  const char* selectionStart, const char* selectionEnd) const;
+
     App* m_pythonDelegate;
     bool m_autocomplete;
     const char* m_autocompletionEnd;
+    mutable int m_numberOfValidLineStates;
+    mutable LineState m_lineStates[k_maxNumberOfLineStates];
+    mutable CachedLine m_cachedLines[k_numberOfCachedLines];
   };
 
  private:
+  // Length of the current token of lex, which starts at tokenPosition
+  static size_t TokenLength(_mp_lexer_t* lex, const char* tokenPosition);
   void prepareVariableBoxBeforeOpening();
   void removeAutocompletion();
   void addAutocompletion(int index = 0);
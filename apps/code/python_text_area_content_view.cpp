@@ -0,0 +1,538 @@
+#include "python_text_area.h"
+
+#include <escher/palette.h>
+#include <ion/unicode/utf8_helper.h>
+#include <python/port/port.h>
+
+#include "app.h"
+
+/* py/parsenum.h is a C header which uses C keyword restrict.
+ * It does not exist in C++ so we define it here in order to be able to include
+ * py/parsenum.h header. */
+#ifdef __cplusplus
+#define restrict  // disable
+#endif
+
+extern "C" {
+#include "py/lexer.h"
+#include "py/nlr.h"
+#include "py/parsenum.h"
+}
+#include <stdlib.h>
+
+#include <algorithm>
+
+using namespace Escher;
+
+namespace Code {
+
+constexpr KDColor CommentColor = KDColor::RGB24(0x999988);
+constexpr KDColor NumberColor = KDColor::RGB24(0x009999);
+constexpr KDColor KeywordColor = KDColor::RGB24(0xFF000C);
+// constexpr KDColor BuiltinColor = KDColor::RGB24(0x0086B3);
+constexpr KDColor OperatorColor = KDColor::RGB24(0xd73a49);
+constexpr KDColor StringColor = KDColor::RGB24(0x032f62);
+constexpr KDColor AutocompleteColor = KDColor::RGB24(0xC6C6C6);
+constexpr KDColor BackgroundColor = KDColorWhite;
+constexpr KDColor HighlightColor = Palette::Select;
+constexpr KDColor DefaultColor = KDColorBlack;
+
+static inline KDColor TokenColor(mp_token_kind_t tokenKind) {
+  if (tokenKind == MP_TOKEN_STRING) {
+    return StringColor;
+  }
+  if (tokenKind == MP_TOKEN_INTEGER || tokenKind == MP_TOKEN_FLOAT_OR_IMAG) {
+    return NumberColor;
+  }
+  static_assert(MP_TOKEN_ELLIPSIS + 1 == MP_TOKEN_KW_FALSE &&
+                    MP_TOKEN_KW_FALSE + 1 == MP_TOKEN_KW_NONE &&
+                    MP_TOKEN_KW_NONE + 1 == MP_TOKEN_KW_TRUE &&
+                    MP_TOKEN_KW_TRUE + 1 == MP_TOKEN_KW___DEBUG__ &&
+                    MP_TOKEN_KW___DEBUG__ + 1 == MP_TOKEN_KW_AND &&
+                    MP_TOKEN_KW_AND + 1 == MP_TOKEN_KW_AS &&
+                    MP_TOKEN_KW_AS + 1 == MP_TOKEN_KW_ASSERT
+                    /* Here there are keywords that depend on
+                     * MICROPY_PY_ASYNC_AWAIT, we do not test them */
+                    && MP_TOKEN_KW_BREAK + 1 == MP_TOKEN_KW_CLASS &&
+                    MP_TOKEN_KW_CLASS + 1 == MP_TOKEN_KW_CONTINUE &&
+                    MP_TOKEN_KW_CONTINUE + 1 == MP_TOKEN_KW_DEF &&
+                    MP_TOKEN_KW_DEF + 1 == MP_TOKEN_KW_DEL &&
+                    MP_TOKEN_KW_DEL + 1 == MP_TOKEN_KW_ELIF &&
+                    MP_TOKEN_KW_ELIF + 1 == MP_TOKEN_KW_ELSE &&
+                    MP_TOKEN_KW_ELSE + 1 == MP_TOKEN_KW_EXCEPT &&
+                    MP_TOKEN_KW_EXCEPT + 1 == MP_TOKEN_KW_FINALLY &&
+                    MP_TOKEN_KW_FINALLY + 1 == MP_TOKEN_KW_FOR &&
+                    MP_TOKEN_KW_FOR + 1 == MP_TOKEN_KW_FROM &&
+                    MP_TOKEN_KW_FROM + 1 == MP_TOKEN_KW_GLOBAL &&
+                    MP_TOKEN_KW_GLOBAL + 1 == MP_TOKEN_KW_IF &&
+                    MP_TOKEN_KW_IF + 1 == MP_TOKEN_KW_IMPORT &&
+                    MP_TOKEN_KW_IMPORT + 1 == MP_TOKEN_KW_IN &&
+                    MP_TOKEN_KW_IN + 1 == MP_TOKEN_KW_IS &&
+                    MP_TOKEN_KW_IS + 1 == MP_TOKEN_KW_LAMBDA &&
+                    MP_TOKEN_KW_LAMBDA + 1 == MP_TOKEN_KW_NONLOCAL &&
+                    MP_TOKEN_KW_NONLOCAL + 1 == MP_TOKEN_KW_NOT &&
+                    MP_TOKEN_KW_NOT + 1 == MP_TOKEN_KW_OR &&
+                    MP_TOKEN_KW_OR + 1 == MP_TOKEN_KW_PASS &&
+                    MP_TOKEN_KW_PASS + 1 == MP_TOKEN_KW_RAISE &&
+                    MP_TOKEN_KW_RAISE + 1 == MP_TOKEN_KW_RETURN &&
+                    MP_TOKEN_KW_RETURN + 1 == MP_TOKEN_KW_TRY &&
+                    MP_TOKEN_KW_TRY + 1 == MP_TOKEN_KW_WHILE &&
+                    MP_TOKEN_KW_WHILE + 1 == MP_TOKEN_KW_WITH &&
+                    MP_TOKEN_KW_WITH + 1 == MP_TOKEN_KW_YIELD &&
+                    MP_TOKEN_KW_YIELD + 1 == MP_TOKEN_OP_ASSIGN &&
+                    MP_TOKEN_OP_ASSIGN + 1 == MP_TOKEN_OP_TILDE,
+                "MP_TOKEN order changed, so Code::PythonTextArea::TokenColor "
+                "might need to change too.");
+  if (tokenKind >= MP_TOKEN_KW_FALSE && tokenKind <= MP_TOKEN_KW_YIELD) {
+    return KeywordColor;
+  }
+  static_assert(
+      MP_TOKEN_OP_TILDE + 1 == MP_TOKEN_OP_LESS &&
+          MP_TOKEN_OP_LESS + 1 == MP_TOKEN_OP_MORE &&
+          MP_TOKEN_OP_MORE + 1 == MP_TOKEN_OP_DBL_EQUAL &&
+          MP_TOKEN_OP_DBL_EQUAL + 1 == MP_TOKEN_OP_LESS_EQUAL &&
+          MP_TOKEN_OP_LESS_EQUAL + 1 == MP_TOKEN_OP_MORE_EQUAL &&
+          MP_TOKEN_OP_MORE_EQUAL + 1 == MP_TOKEN_OP_NOT_EQUAL &&
+          MP_TOKEN_OP_NOT_EQUAL + 1 == MP_TOKEN_OP_PIPE &&
+          MP_TOKEN_OP_PIPE + 1 == MP_TOKEN_OP_CARET &&
+          MP_TOKEN_OP_CARET + 1 == MP_TOKEN_OP_AMPERSAND &&
+          MP_TOKEN_OP_AMPERSAND + 1 == MP_TOKEN_OP_DBL_LESS &&
+          MP_TOKEN_OP_DBL_LESS + 1 == MP_TOKEN_OP_DBL_MORE &&
+          MP_TOKEN_OP_DBL_MORE + 1 == MP_TOKEN_OP_PLUS &&
+          MP_TOKEN_OP_PLUS + 1 == MP_TOKEN_OP_MINUS &&
+          MP_TOKEN_OP_MINUS + 1 == MP_TOKEN_OP_STAR &&
+          MP_TOKEN_OP_STAR + 1 == MP_TOKEN_OP_AT &&
+          MP_TOKEN_OP_AT + 1 == MP_TOKEN_OP_DBL_SLASH &&
+          MP_TOKEN_OP_DBL_SLASH + 1 == MP_TOKEN_OP_SLASH &&
+          MP_TOKEN_OP_SLASH + 1 == MP_TOKEN_OP_PERCENT &&
+          MP_TOKEN_OP_PERCENT + 1 == MP_TOKEN_OP_DBL_STAR &&
+          MP_TOKEN_OP_DBL_STAR + 1 == MP_TOKEN_DEL_PIPE_EQUAL &&
+          MP_TOKEN_DEL_PIPE_EQUAL + 1 == MP_TOKEN_DEL_CARET_EQUAL &&
+          MP_TOKEN_DEL_CARET_EQUAL + 1 == MP_TOKEN_DEL_AMPERSAND_EQUAL &&
+          MP_TOKEN_DEL_AMPERSAND_EQUAL + 1 == MP_TOKEN_DEL_DBL_LESS_EQUAL &&
+          MP_TOKEN_DEL_DBL_LESS_EQUAL + 1 == MP_TOKEN_DEL_DBL_MORE_EQUAL &&
+          MP_TOKEN_DEL_DBL_MORE_EQUAL + 1 == MP_TOKEN_DEL_PLUS_EQUAL &&
+          MP_TOKEN_DEL_PLUS_EQUAL + 1 == MP_TOKEN_DEL_MINUS_EQUAL &&
+          MP_TOKEN_DEL_MINUS_EQUAL + 1 == MP_TOKEN_DEL_STAR_EQUAL &&
+          MP_TOKEN_DEL_STAR_EQUAL + 1 == MP_TOKEN_DEL_AT_EQUAL &&
+          MP_TOKEN_DEL_AT_EQUAL + 1 == MP_TOKEN_DEL_DBL_SLASH_EQUAL &&
+          MP_TOKEN_DEL_DBL_SLASH_EQUAL + 1 == MP_TOKEN_DEL_SLASH_EQUAL &&
+          MP_TOKEN_DEL_SLASH_EQUAL + 1 == MP_TOKEN_DEL_PERCENT_EQUAL &&
+          MP_TOKEN_DEL_PERCENT_EQUAL + 1 == MP_TOKEN_DEL_DBL_STAR_EQUAL &&
+          MP_TOKEN_DEL_DBL_STAR_EQUAL + 1 == MP_TOKEN_DEL_PAREN_OPEN &&
+          MP_TOKEN_DEL_PAREN_OPEN + 1 == MP_TOKEN_DEL_PAREN_CLOSE &&
+          MP_TOKEN_DEL_PAREN_CLOSE + 1 == MP_TOKEN_DEL_BRACKET_OPEN &&
+          MP_TOKEN_DEL_BRACKET_OPEN + 1 == MP_TOKEN_DEL_BRACKET_CLOSE &&
+          MP_TOKEN_DEL_BRACKET_CLOSE + 1 == MP_TOKEN_DEL_BRACE_OPEN &&
+          MP_TOKEN_DEL_BRACE_OPEN + 1 == MP_TOKEN_DEL_BRACE_CLOSE &&
+          MP_TOKEN_DEL_BRACE_CLOSE + 1 == MP_TOKEN_DEL_COMMA &&
+          MP_TOKEN_DEL_COMMA + 1 == MP_TOKEN_DEL_COLON &&
+          MP_TOKEN_DEL_COLON + 1 == MP_TOKEN_DEL_PERIOD &&
+          MP_TOKEN_DEL_PERIOD + 1 == MP_TOKEN_DEL_SEMICOLON &&
+          MP_TOKEN_DEL_SEMICOLON + 1 == MP_TOKEN_DEL_EQUAL &&
+          MP_TOKEN_DEL_EQUAL + 1 == MP_TOKEN_DEL_MINUS_MORE,
+      "MP_TOKEN order changed, so Code::PythonTextArea::TokenColor might need "
+      "to change too.");
+
+  if ((tokenKind >= MP_TOKEN_OP_TILDE &&
+       tokenKind <= MP_TOKEN_DEL_DBL_STAR_EQUAL) ||
+      tokenKind == MP_TOKEN_DEL_EQUAL || tokenKind == MP_TOKEN_DEL_MINUS_MORE) {
+    return OperatorColor;
+  }
+  return DefaultColor;
+}
+
+size_t PythonTextArea::TokenLength(mp_lexer_t *lex,
+                                   const char *tokenPosition) {
+  /* The lexer stores the beginning of the current token and of the next token,
+   * so we just use that. */
+  if (lex->line > 1) {
+    /* The next token is on the next line, so we cannot just make the difference
+     * of the columns. */
+    return UTF8Helper::CodePointSearch(tokenPosition, '\n') - tokenPosition;
+  }
+  return lex->column - lex->tok_column;
+}
+void PythonTextArea::ContentView::clearRect(KDContext *ctx, KDRect rect) const {
+  ctx->fillRect(rect, BackgroundColor);
+}
+
+#define LOG_DRAWING 0
+#if LOG_DRAWING
+#include <stdio.h>
+#define LOG_DRAW(...) printf(__VA_ARGS__)
+#else
+#define LOG_DRAW(...)
+#endif
+
+static const char *EndOfTripleQuotedString(const char *text, const char *end,
+                                           char quote) {
+  while (text + 2 < end) {
+    if (*text == '\\') {
+      text += 2;
+    } else if (text[0] == quote && text[1] == quote && text[2] == quote) {
+      return text + 3;
+    } else {
+      text++;
+    }
+  }
+  return nullptr;
+}
+
+PythonTextArea::ContentView::LineState PythonTextArea::ContentView::ScanLine(
+    const char *text, const char *end, LineState state, const char **codeStart,
+    const char **codeEnd) {
+  if (codeStart != nullptr) {
+    *codeStart = end;
+  }
+  if (codeEnd != nullptr) {
+    *codeEnd = end;
+  }
+  if (state != LineState::Code) {
+    text = EndOfTripleQuotedString(
+        text, end, state == LineState::SingleQuotedString ? '\'' : '"');
+    if (text == nullptr) {
+      return state;
+    }
+  }
+  if (codeStart != nullptr) {
+    *codeStart = text;
+  }
+  while (text < end && *text != '#') {
+    char quote = *text;
+    if (quote != '\'' && quote != '"') {
+      text++;
+      continue;
+    }
+    if (text + 2 < end && text[1] == quote && text[2] == quote) {
+      const char *stringEnd = EndOfTripleQuotedString(text + 3, end, quote);
+      if (stringEnd == nullptr) {
+        if (codeEnd != nullptr) {
+          *codeEnd = text;
+        }
+        return quote == '\'' ? LineState::SingleQuotedString
+                             : LineState::DoubleQuotedString;
+      }
+      text = stringEnd;
+      continue;
+    }
+    // Other strings end with the line anyway
+    text++;
+    while (text < end && *text != quote) {
+      text += *text == '\\' ? 2 : 1;
+    }
+    text++;
+  }
+  return LineState::Code;
+}
+
+PythonTextArea::ContentView::LineState
+PythonTextArea::ContentView::lineStateAt(int line,
+                                         const char *lineText) const {
+  assert(m_numberOfValidLineStates >= 1);
+  int knownLine =
+      std::min(m_numberOfValidLineStates, k_maxNumberOfLineStates) - 1;
+  if (line <= knownLine) {
+    return m_lineStates[line];
+  }
+  // Scan the lines from the last known state
+  const char *text = lineText;
+  for (int i = line; i > knownLine; i--) {
+    assert(text > m_text.text());
+    text--;
+    while (text > m_text.text() && *(text - 1) != '\n') {
+      text--;
+    }
+  }
+  LineState state = m_lineStates[knownLine];
+  for (int i = knownLine + 1; i <= line; i++) {
+    const char *end = UTF8Helper::CodePointSearch(text, '\n');
+    state = ScanLine(text, end, state, nullptr, nullptr);
+    text = end + 1;
+    if (i < k_maxNumberOfLineStates) {
+      m_lineStates[i] = state;
+      m_numberOfValidLineStates = i + 1;
+    }
+  }
+  assert(text == lineText);
+  return state;
+}
+
+const char *PythonTextArea::ContentView::computeRuns(
+    const char *text, const char *from, const char *end, LineState state,
+    Run *runs, int *numberOfRuns) const {
+  *numberOfRuns = 0;
+  /* Runs are extended over the spaces before them, and merged with the
+   * previous run if they have the same color. */
+  auto addRun = [&](const char *runEnd, KDColor color) {
+    uint16_t offset = runEnd - text;
+    int n = *numberOfRuns;
+    if ((n > 0 && offset <= runs[n - 1].end) || (n == 0 && runEnd <= from)) {
+      return true;
+    }
+    if (n > 0 && runs[n - 1].color == color) {
+      runs[n - 1].end = offset;
+      return true;
+    }
+    if (n == k_maxNumberOfRuns) {
+      return false;
+    }
+    runs[n] = {offset, color};
+    *numberOfRuns = n + 1;
+    return true;
+  };
+  auto runsEnd = [&]() {
+    return *numberOfRuns == 0 ? from : text + runs[*numberOfRuns - 1].end;
+  };
+
+  const char *codeStart;
+  const char *codeEnd;
+  ScanLine(from, end, state, &codeStart, &codeEnd);
+  addRun(codeStart, StringColor);
+
+  /* We're using the MicroPython lexer on the code, which won't accept a line
+   * starting with a whitespace. So we're discarding leading whitespaces
+   * beforehand. */
+  const char *firstNonSpace = UTF8Helper::NotCodePointSearch(codeStart, ' ');
+  assert(firstNonSpace <= codeEnd);
+  const char *autocompleteStart = m_autocomplete ? m_cursorLocation : nullptr;
+  bool isFull = false;
+
+  nlr_buf_t nlr;
+  if (firstNonSpace < codeEnd && nlr_push(&nlr) == 0) {
+    mp_lexer_t *lex = mp_lexer_new_from_str_len(0, firstNonSpace,
+                                                codeEnd - firstNonSpace, 0);
+    LOG_DRAW("Pop token %d\n", lex->tok_kind);
+
+    while (lex->tok_kind != MP_TOKEN_NEWLINE && lex->tok_kind != MP_TOKEN_END) {
+      const char *tokenFrom = firstNonSpace + lex->tok_column - 1;
+      const char *tokenEnd =
+          std::min(tokenFrom + TokenLength(lex, tokenFrom), codeEnd);
+
+      bool skipCombining = false;
+      if (*(tokenEnd - 1) != 0) {
+        /* The previous if is to prevent entering the following loop if already
+         * at end of buffer and avoid reading nextCodePoint out of the buffer.
+         */
+        UTF8Decoder decoder(text, tokenEnd);
+        while (decoder.nextCodePoint().isCombining()) {
+          /* If combined different =/ ends up in a python buffer, the lexer will
+           * take the = equal sign and leave the combining / alone. In this case
+           * we manually extend the token to include the / part and skip the
+           * next token. */
+          tokenEnd = decoder.stringPosition();
+          skipCombining = true;
+        }
+      }
+
+      // If the token is being autocompleted, use DefaultColor
+      KDColor color =
+          (tokenFrom <= autocompleteStart && autocompleteStart < tokenEnd)
+              ? DefaultColor
+              : TokenColor(lex->tok_kind);
+
+      if (color != DefaultColor && (lex->tok_kind == MP_TOKEN_INTEGER ||
+                                    lex->tok_kind == MP_TOKEN_FLOAT_OR_IMAG)) {
+        /* Check if the token can actually be parsed because lexer might label
+         * tokens that cannot be parsed as integer or float */
+        nlr_buf_t nlrNumberColorParse;
+        if (nlr_push(&nlrNumberColorParse) == 0) {
+          /* Use ex->vstr.len instead of tokenLength because it translates
+           * escaped chars as the interpreter would do. */
+          if (lex->tok_kind == MP_TOKEN_INTEGER) {
+            mp_parse_num_integer(tokenFrom, lex->vstr.len, 0, NULL);
+          } else {
+            mp_parse_num_decimal(tokenFrom, lex->vstr.len, true, false, NULL);
+          }
+          nlr_pop();
+        } else {
+          // Parsing raised an exception, use DefaultColor.
+          color = DefaultColor;
+        }
+      }
+
+      LOG_DRAW("Color \"%.*s\" for token %d\n", tokenEnd - tokenFrom,
+               tokenFrom, lex->tok_kind);
+      if (!addRun(tokenEnd, color)) {
+        isFull = true;
+        break;
+      }
+
+      if (skipCombining) {
+        mp_lexer_to_next(lex);
+      }
+      mp_lexer_to_next(lex);
+      LOG_DRAW("Pop token %d\n", lex->tok_kind);
+    }
+
+    mp_lexer_free(lex);
+    nlr_pop();
+  } else if (firstNonSpace < codeEnd) {  // Uncaught exception
+    MicroPython::ExecutionEnvironment::HandleExceptionSilently();
+    if (!addRun(codeEnd, DefaultColor)) {
+      return runsEnd();
+    }
+  }
+  if (isFull) {
+    return runsEnd();
+  }
+
+  // Even if the token is being autocompleted, use CommentColor
+  if (!addRun(codeEnd, CommentColor)) {
+    return runsEnd();
+  }
+  // The string continued on the lines below
+  if (!addRun(end, StringColor)) {
+    return runsEnd();
+  }
+  return end;
+}
+
+void PythonTextArea::ContentView::drawRuns(
+    KDContext *ctx, int line, const char *text, const char *from,
+    const Run *runs, int numberOfRuns, const char *selectionStart,
+    const char *selectionEnd) const {
+  int column = UTF8Helper::GlyphOffsetAtCodePoint(text, from);
+  for (int i = 0; i < numberOfRuns; i++) {
+    const char *runEnd = text + runs[i].end;
+    drawStringAt(ctx, line, column, from, runEnd - from, runs[i].color,
+                 BackgroundColor, selectionStart, selectionEnd, HighlightColor);
+    column += UTF8Helper::GlyphOffsetAtCodePoint(from, runEnd);
+    from = runEnd;
+  }
+}
+
+template <typename T>
+void PythonTextArea::ContentView::colorLine(int line, const char *text,
+                                            size_t byteLength,
+                                            T runsAction) const {
+  const char *end = text + byteLength;
+  const char *autocompleteStart = m_autocomplete ? m_cursorLocation : nullptr;
+  // The colors of the autocompleted line change with the cursor
+  bool isCacheable = !(autocompleteStart >= text && autocompleteStart <= end);
+  CachedLine *cachedLine = &m_cachedLines[line % k_numberOfCachedLines];
+
+  const char *position = text;
+  if (isCacheable && cachedLine->line == line) {
+    runsAction(text, cachedLine->runs, cachedLine->numberOfRuns);
+    if (cachedLine->numberOfRuns > 0) {
+      position = text + cachedLine->runs[cachedLine->numberOfRuns - 1].end;
+    }
+  } else if (position < end) {
+    // Lex the line, but only the runs that fit are cached
+    Run *runs = isCacheable ? cachedLine->runs : nullptr;
+    Run uncachedRuns[k_maxNumberOfRuns];
+    int numberOfRuns;
+    position = computeRuns(text, text, end, lineStateAt(line, text),
+                           runs ? runs : uncachedRuns, &numberOfRuns);
+    runsAction(text, runs ? runs : uncachedRuns, numberOfRuns);
+    if (isCacheable) {
+      cachedLine->line = line;
+      cachedLine->numberOfRuns = numberOfRuns;
+    }
+  }
+  while (position < end) {
+    Run runs[k_maxNumberOfRuns];
+    int numberOfRuns;
+    const char *runsStart = position;
+    position = computeRuns(text, runsStart, end, LineState::Code, runs,
+                           &numberOfRuns);
+    runsAction(runsStart, runs, numberOfRuns);
+  }
+}
+
+void PythonTextArea::ContentView::drawLine(KDContext *ctx, int line,
+                                           const char *text, size_t byteLength,
+                                           int fromColumn, int toColumn,
+                                           const char *selectionStart,
+                                           const char *selectionEnd) const {
+  LOG_DRAW("Drawing \"%.*s\"\n", byteLength, text);
+
+  assert(m_pythonDelegate->isPythonUser(this));
+
+  colorLine(line, text, byteLength,
+            [&](const char *from, const Run *runs, int numberOfRuns) {
+              drawRuns(ctx, line, text, from, runs, numberOfRuns,
+                       selectionStart, selectionEnd);
+            });
+
+  // Redraw the autocompleted word in the right color
+  const char *autocompleteStart = m_autocomplete ? m_cursorLocation : nullptr;
+  if (m_autocomplete && autocompleteStart >= text &&
+      autocompleteStart < text + byteLength) {
+    assert(m_autocompletionEnd != nullptr &&
+           m_autocompletionEnd > autocompleteStart);
+    drawStringAt(
+        ctx, line, UTF8Helper::GlyphOffsetAtCodePoint(text, autocompleteStart),
+        autocompleteStart,
+        std::min(text + byteLength, m_autocompletionEnd) - autocompleteStart,
+        AutocompleteColor, BackgroundColor, nullptr, nullptr, HighlightColor);
+  }
+}
+
+KDColor PythonTextArea::ContentView::colorAtPosition(
+    const char *position) const {
+  int line = m_text.positionAtPointer(position).line();
+  const char *lineText = position;
+  while (lineText > m_text.text() && *(lineText - 1) != '\n') {
+    lineText--;
+  }
+  const char *lineEnd = UTF8Helper::CodePointSearch(position, '\n');
+  KDColor color = DefaultColor;
+  colorLine(line, lineText, lineEnd - lineText,
+            [&](const char *from, const Run *runs, int numberOfRuns) {
+              for (int i = 0; i < numberOfRuns; i++) {
+                const char *runEnd = lineText + runs[i].end;
+                if (from <= position && position < runEnd) {
+                  color = runs[i].color;
+                }
+                from = runEnd;
+              }
+            });
+  return color;
+}
+
+void PythonTextArea::ContentView::textDidChangeFromPosition(
+    const char *position) {
+  int line = m_text.positionAtPointer(position).line();
+  for (CachedLine &cachedLine : m_cachedLines) {
+    if (cachedLine.line >= line) {
+      cachedLine.line = -1;
+    }
+  }
+  // The states of the lines up to the edited one do not depend on it
+  bool nextLineStateWasKnown = line + 1 < m_numberOfValidLineStates;
+  LineState previousNextLineState =
+      nextLineStateWasKnown ? m_lineStates[line + 1] : LineState::Code;
+  m_numberOfValidLineStates = std::min(m_numberOfValidLineStates, line + 1);
+
+  const char *lineText = position;
+  while (lineText > m_text.text() && *(lineText - 1) != '\n') {
+    lineText--;
+  }
+  const char *lineEnd = UTF8Helper::CodePointSearch(position, '\n');
+  if (*lineEnd == 0) {
+    return;
+  }
+  /* Compute the state of the next line right away, to tell whether the edit
+   * changed the colors of the lines below. */
+  LineState nextLineState = lineStateAt(line + 1, lineEnd + 1);
+  if (!nextLineStateWasKnown || nextLineState != previousNextLineState) {
+    reloadRectFromPosition(position, true);
+  }
+}
+
+KDRect PythonTextArea::ContentView::dirtyRectFromPosition(
+    const char *position, bool includeFollowingLines) const {
+  /* Mark the whole line as dirty.
+   * TextArea has a very conservative approach and only dirties the surroundings
+   * of the current character. That works for plain text, but when doing syntax
+   * highlighting, you may want to redraw the surroundings as well. For example,
+   * if editing "def foo" into "df foo", you'll want to redraw "df". */
+  KDRect baseDirtyRect = TextArea::ContentView::dirtyRectFromPosition(
+      position, includeFollowingLines);
+  return KDRect(bounds().x(), baseDirtyRect.y(), bounds().width(),
+                baseDirtyRect.height());
+}
+
+}  // namespace Code
@@ -369,14 +369,20 @@ constexpr ToolboxMessageTree KandinskyModuleChildren[] = {
         I18n::Message::PythonCommandKandinskyFunctionWithoutArg),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandGetPixel,
                              I18n::Message::PythonGetPixel),
+    ToolboxMessageTree::Leaf(I18n::Message::PythonCommandGetPixels,
+                             I18n::Message::PythonGetPixels),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandSetPixel,
                              I18n::Message::PythonSetPixel),
+    ToolboxMessageTree::Leaf(I18n::Message::PythonCommandSetPixels,
+                             I18n::Message::PythonSetPixels),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandColor,
                              I18n::Message::PythonColor),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandDrawString,
                              I18n::Message::PythonDrawString),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandFillRect,
-                             I18n::Message::PythonFillRect)};
+                             I18n::Message::PythonFillRect),
+    ToolboxMessageTree::Leaf(I18n::Message::PythonCommandDrawPolyline,
+                             I18n::Message::PythonDrawPolyline)};
 
 constexpr ToolboxMessageTree IonModuleChildren[] = {
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandImportIon,
@@ -689,6 +695,8 @@ constexpr ToolboxMessageTree catalogChildren[] = {
                              I18n::Message::PythonDivMod),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandDot,
                              I18n::Message::PythonDot),
+    ToolboxMessageTree::Leaf(I18n::Message::PythonCommandDrawPolyline,
+                             I18n::Message::PythonDrawPolyline),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandDrawString,
                              I18n::Message::PythonDrawString),
     ToolboxMessageTree::Leaf(I18n::Message::E, I18n::Message::PythonConstantE,
@@ -745,6 +753,8 @@ constexpr ToolboxMessageTree catalogChildren[] = {
                              I18n::Message::PythonGcd),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandGetPixel,
                              I18n::Message::PythonGetPixel),
+    ToolboxMessageTree::Leaf(I18n::Message::PythonCommandGetPixels,
+                             I18n::Message::PythonGetPixels),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandGetrandbits,
                              I18n::Message::PythonGetrandbits),
     ToolboxMessageTree::Leaf(I18n::Message::PythonTurtleCommandGoto,
@@ -940,6 +950,8 @@ constexpr ToolboxMessageTree catalogChildren[] = {
                              I18n::Message::PythonSeed),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandSetPixel,
                              I18n::Message::PythonSetPixel),
+    ToolboxMessageTree::Leaf(I18n::Message::PythonCommandSetPixels,
+                             I18n::Message::PythonSetPixels),
     ToolboxMessageTree::Leaf(I18n::Message::PythonTurtleCommandSetheading,
                              I18n::Message::PythonTurtleSetheading),
     ToolboxMessageTree::Leaf(I18n::Message::PythonCommandShow,
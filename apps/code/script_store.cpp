@@ -3,6 +3,7 @@
 namespace Code {
 
 constexpr char ScriptStore::k_scriptExtension[];
+constexpr char ScriptStore::k_compiledScriptExtension[];
 
 bool ScriptStore::ScriptNameIsFree(const char* baseName) {
   return ScriptBaseNamed(baseName).isNull();
@@ -26,10 +27,15 @@ bool ScriptStore::IsFull() {
          k_fullFreeSpaceSizeLimit;
 }
 
+void ScriptStore::DeleteCompiledScript(Script script) {
+  Ion::Storage::Record(CompiledScriptName(script.name())).destroy();
+}
+
 const char* ScriptStore::contentOfScript(const char* name,
                                          bool markAsFetched) const {
   Script script = ScriptNamed(name);
-  if (script.isNull()) {
+  // Compiled scripts are not importable
+  if (script.isNull() || !script.hasExtension(k_scriptExtension)) {
     return nullptr;
   }
   if (markAsFetched) {
@@ -38,6 +44,74 @@ const char* ScriptStore::contentOfScript(const char* name,
   return script.content();
 }
 
+const void* ScriptStore::compiledScript(const char* name, size_t* size) const {
+  Script script = ScriptNamed(name);
+  if (script.isNull() || !script.hasExtension(k_scriptExtension)) {
+    return nullptr;
+  }
+  Ion::Storage::Record::Data data = CompiledScriptNamed(name).value();
+  uint32_t checksum;
+  if (data.size < sizeof(checksum)) {
+    return nullptr;
+  }
+  memcpy(&checksum, data.buffer, sizeof(checksum));
+  if (checksum != ContentChecksum(script)) {
+    return nullptr;
+  }
+  *size = data.size - sizeof(checksum);
+  return static_cast<const char*>(data.buffer) + sizeof(checksum);
+}
+
+void* ScriptStore::compiledScriptBuffer(const char* name,
+                                        size_t* capacity) const {
+  Script script = ScriptNamed(name);
+  if (script.isNull() || !script.hasExtension(k_scriptExtension)) {
+    return nullptr;
+  }
+  uint32_t checksum = ContentChecksum(script);
+  DeleteCompiledScript(script);
+  /* The name is taken from the argument since destroying the previous record
+   * may have moved the script. */
+  Ion::Storage::Record::Name compiledName = CompiledScriptName(
+      Ion::Storage::Record::CreateRecordNameFromFullName(name));
+  size_t recordSize = sizeof(Ion::Storage::FileSystem::record_size_t) +
+                      Ion::Storage::Record::SizeOfName(compiledName) +
+                      sizeof(checksum);
+  // Checking the space first avoids the storage full warning
+  if (Ion::Storage::FileSystem::sharedFileSystem->availableSize() <
+      recordSize + k_compiledScriptsReservedSpace) {
+    return nullptr;
+  }
+  const void* dataChunks[] = {&checksum};
+  size_t sizeChunks[] = {sizeof(checksum)};
+  if (Ion::Storage::FileSystem::sharedFileSystem->createRecordWithDataChunks(
+          compiledName, dataChunks, sizeChunks, 1) !=
+      Ion::Storage::Record::ErrorStatus::None) {
+    return nullptr;
+  }
+  /* As the editor does with the scripts, the bytecode is written in place at
+   * the end of the record, which is given all the available space. */
+  Ion::Storage::Record record(compiledName);
+  Ion::Storage::FileSystem::sharedFileSystem->putAvailableSpaceAtEndOfRecord(
+      record);
+  Ion::Storage::Record::Data data = record.value();
+  *capacity =
+      data.size - sizeof(checksum) - k_compiledScriptsReservedSpace;
+  return const_cast<char*>(static_cast<const char*>(data.buffer)) +
+         sizeof(checksum);
+}
+
+void ScriptStore::compiledScriptWasWritten(const char* name,
+                                           size_t size) const {
+  Ion::Storage::Record record = CompiledScriptNamed(name);
+  size_t writtenSize = sizeof(uint32_t) + size;
+  Ion::Storage::FileSystem::sharedFileSystem->getAvailableSpaceFromEndOfRecord(
+      record, record.value().size - writtenSize);
+  if (size == 0) {
+    record.destroy();
+  }
+}
+
 void ScriptStore::ClearVariableBoxFetchInformation() {
   // TODO optimize fetches
   const int scriptsCount = NumberOfScripts();
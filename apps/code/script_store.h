@@ -16,6 +16,9 @@ class ScriptStore : public MicroPython::ScriptProvider {
  public:
   constexpr static char k_scriptExtension[] = "py";
   constexpr static size_t k_scriptExtensionLength = 2;
+  /* A compiled script record holds the checksum of the script content it was
+   * compiled from, followed by its bytecode. */
+  constexpr static char k_compiledScriptExtension[] = "mpy";
 
   // Storage information
   static bool ScriptNameIsFree(const char* baseName);
@@ -45,10 +48,21 @@ class ScriptStore : public MicroPython::ScriptProvider {
   }
   static void DeleteAllScripts();
   static bool IsFull();
+  /* Compiled scripts only live while the app is open, so that they never
+   * take the storage other apps need. */
+  static void DeleteCompiledScripts() {
+    Ion::Storage::FileSystem::sharedFileSystem->destroyRecordsWithExtension(
+        k_compiledScriptExtension);
+  }
+  static void DeleteCompiledScript(Script script);
 
   /* MicroPython::ScriptProvider */
   const char* contentOfScript(const char* name,
                               bool markAsFetched) const override;
+  const void* compiledScript(const char* name, size_t* size) const override;
+  void* compiledScriptBuffer(const char* name,
+                             size_t* capacity) const override;
+  void compiledScriptWasWritten(const char* name, size_t size) const override;
 
   static void ClearVariableBoxFetchInformation();
   static void ClearConsoleFetchInformation();
@@ -65,6 +79,25 @@ class ScriptStore : public MicroPython::ScriptProvider {
       Script::k_defaultScriptNameMaxSize + k_scriptExtensionLength + 1 + 20 +
       10;
 
+  /* Compiled scripts leave this space available, for the scripts to be edited
+   * or added. */
+  constexpr static size_t k_compiledScriptsReservedSpace =
+      Ion::Storage::FileSystem::k_storageSize / 4;
+
+  static Ion::Storage::Record::Name CompiledScriptName(
+      Ion::Storage::Record::Name scriptName) {
+    return {scriptName.baseName, scriptName.baseNameLength,
+            k_compiledScriptExtension};
+  }
+  static Ion::Storage::Record CompiledScriptNamed(const char* name) {
+    return Ion::Storage::Record(CompiledScriptName(
+        Ion::Storage::Record::CreateRecordNameFromFullName(name)));
+  }
+  static uint32_t ContentChecksum(Script script) {
+    return Ion::crc32Byte(reinterpret_cast<const uint8_t*>(script.content()),
+                          strlen(script.content()));
+  }
+
   static Ion::Storage::Record::ErrorStatus AddScriptFromTemplate(
       const ScriptTemplate* scriptTemplate) {
     return Script::Create(scriptTemplate->name(), scriptTemplate->content());
@@ -0,0 +1,152 @@
+#include <python/port/port.h>
+#include <quiz.h>
+#include <string.h>
+
+#include "../python_text_area.h"
+
+using namespace Code;
+
+constexpr KDColor k_commentColor = KDColor::RGB24(0x999988);
+constexpr KDColor k_numberColor = KDColor::RGB24(0x009999);
+constexpr KDColor k_keywordColor = KDColor::RGB24(0xFF000C);
+constexpr KDColor k_operatorColor = KDColor::RGB24(0xd73a49);
+constexpr KDColor k_stringColor = KDColor::RGB24(0x032f62);
+constexpr KDColor k_defaultColor = KDColorBlack;
+
+class HighlightedTextArea : public PythonTextArea {
+ public:
+  // The highlighting only needs the lexer, not the Code app
+  class View : public ContentView {
+   public:
+    View() : ContentView(nullptr, KDFont::Size::Large) {}
+  };
+};
+
+static char s_pythonHeap[8192];
+static char s_text[1000];
+
+static void assert_color_is(const HighlightedTextArea::View &view,
+                            const char *token, KDColor color,
+                            int occurrence = 0) {
+  const char *position = strstr(s_text, token);
+  for (int i = 0; i < occurrence; i++) {
+    position = strstr(position + 1, token);
+  }
+  quiz_assert(position != nullptr);
+  quiz_assert(view.colorAtPosition(position) == color);
+}
+
+static void set_text(HighlightedTextArea::View *view, const char *text) {
+  strlcpy(s_text, text, sizeof(s_text));
+  view->setText(s_text, sizeof(s_text));
+}
+
+QUIZ_CASE(code_python_text_area_multiline_strings) {
+  MicroPython::init(s_pythonHeap, s_pythonHeap + sizeof(s_pythonHeap));
+  HighlightedTextArea::View view;
+
+  set_text(&view, "a = '''x\nif = 1\n'''\nb = 2");
+  assert_color_is(view, "a", k_defaultColor);
+  assert_color_is(view, "=", k_operatorColor);
+  assert_color_is(view, "if", k_stringColor);
+  assert_color_is(view, "1", k_stringColor);
+  assert_color_is(view, "b", k_defaultColor);
+  assert_color_is(view, "2", k_numberColor);
+
+  set_text(&view, "s = \"\"\"\ndef\n\"\"\" # c\ndef f(): pass");
+  assert_color_is(view, "def", k_stringColor);
+  assert_color_is(view, "# c", k_commentColor);
+  assert_color_is(view, "def", k_keywordColor, 1);
+
+  // Quotes of the other kind do not close the string
+  set_text(&view, "'''\n\"\"\"\nif\n'''\nif");
+  assert_color_is(view, "if", k_stringColor);
+  assert_color_is(view, "if", k_keywordColor, 1);
+  MicroPython::deinit();
+}
+
+QUIZ_CASE(code_python_text_area_escaped_quotes) {
+  MicroPython::init(s_pythonHeap, s_pythonHeap + sizeof(s_pythonHeap));
+  HighlightedTextArea::View view;
+
+  set_text(&view, "s = 'a\\'b' + 1\nt = 2");
+  assert_color_is(view, "1", k_numberColor);
+  assert_color_is(view, "2", k_numberColor);
+
+  // An escaped quote does not close a triple-quoted string
+  set_text(&view, "t = '''a\\''' if\nopen''' + 1\nv = 2");
+  assert_color_is(view, "if", k_stringColor);
+  assert_color_is(view, "open", k_stringColor);
+  assert_color_is(view, "1", k_numberColor);
+  assert_color_is(view, "2", k_numberColor);
+  MicroPython::deinit();
+}
+
+QUIZ_CASE(code_python_text_area_comments) {
+  MicroPython::init(s_pythonHeap, s_pythonHeap + sizeof(s_pythonHeap));
+  HighlightedTextArea::View view;
+
+  set_text(&view, "# it's '''\nx = 1\ny = 2 # \"\"\"\nz = 3");
+  assert_color_is(view, "#", k_commentColor);
+  assert_color_is(view, "1", k_numberColor);
+  assert_color_is(view, "# \"", k_commentColor);
+  assert_color_is(view, "3", k_numberColor);
+  MicroPython::deinit();
+}
+
+QUIZ_CASE(code_python_text_area_edits) {
+  MicroPython::init(s_pythonHeap, s_pythonHeap + sizeof(s_pythonHeap));
+  HighlightedTextArea::View view;
+
+  // Fill the caches before editing
+  set_text(&view, "a = 1\nb = 2\nc = 3");
+  assert_color_is(view, "1", k_numberColor);
+  assert_color_is(view, "2", k_numberColor);
+  assert_color_is(view, "3", k_numberColor);
+
+  // Opening a string colors the lines below
+  view.insertTextAtLocation("'''", strstr(s_text, "1"));
+  assert_color_is(view, "1", k_stringColor);
+  assert_color_is(view, "2", k_stringColor);
+  assert_color_is(view, "3", k_stringColor);
+
+  // Closing it on the next line restores the last line
+  view.insertTextAtLocation("'''", strstr(s_text, "b"));
+  assert_color_is(view, "'''", k_stringColor, 1);
+  assert_color_is(view, "b", k_defaultColor);
+  assert_color_is(view, "2", k_numberColor);
+  assert_color_is(view, "3", k_numberColor);
+
+  // Removing the opening quotes swaps the colors of the lines below
+  char *openingQuotes = strstr(s_text, "'''");
+  view.removeText(openingQuotes, openingQuotes + 3);
+  assert_color_is(view, "1", k_numberColor);
+  assert_color_is(view, "2", k_stringColor);
+  assert_color_is(view, "3", k_stringColor);
+  MicroPython::deinit();
+}
+
+QUIZ_CASE(code_python_text_area_long_lines) {
+  MicroPython::init(s_pythonHeap, s_pythonHeap + sizeof(s_pythonHeap));
+  HighlightedTextArea::View view;
+
+  /* Numbers and operators alternate, which makes more runs than a cached line
+   * holds. */
+  set_text(&view,
+           "x = 1+2+3+4+5+6+7+8+9+10+11+12+13+14+15+16+17+18+19+20 # '''\n"
+           "y = 21+22+23+24+25+26+27+28+29+30+31+32+33+34+35 + '''\n"
+           "if\n'''");
+  for (int i = 0; i < 2; i++) {
+    // The second time, the start of the lines comes from the cache
+    assert_color_is(view, "x", k_defaultColor);
+    assert_color_is(view, "1", k_numberColor);
+    assert_color_is(view, "19", k_numberColor);
+    assert_color_is(view, "+20", k_operatorColor);
+    assert_color_is(view, "20", k_numberColor);
+    assert_color_is(view, "#", k_commentColor);
+    assert_color_is(view, "35", k_numberColor);
+    assert_color_is(view, "'''", k_stringColor, 1);
+    assert_color_is(view, "if", k_stringColor);
+  }
+  MicroPython::deinit();
+}
@@ -0,0 +1,36 @@
+#include <python/test/execution_environment.h>
+#include <quiz.h>
+
+#include "../script_store.h"
+
+using namespace Code;
+
+QUIZ_CASE(code_compiled_scripts) {
+  ScriptStore::DeleteAllScripts();
+  ScriptStore scriptStore;
+  MicroPython::registerScriptProvider(&scriptStore);
+  Script::Create("cached.py", "a = 0.30000000000000004\nb = 2j\n");
+  const char* script = "from cached import *\nprint(a == 0.1 + 0.2, b)\n";
+  size_t size;
+  quiz_assert(scriptStore.compiledScript("cached.py", &size) == nullptr);
+
+  // The first import compiles the script and stores its bytecode
+  assert_script_execution_succeeds(script, "True 2j\n");
+  quiz_assert(scriptStore.compiledScript("cached.py", &size) != nullptr);
+  quiz_assert(scriptStore.compiledScript("cached.mpy", &size) == nullptr);
+  quiz_assert(scriptStore.contentOfScript("cached.mpy", false) == nullptr);
+
+  // The next ones load it, with the exact same constants
+  assert_script_execution_succeeds(script, "True 2j\n");
+
+  // Changing the script outdates its bytecode
+  ScriptStore::ScriptNamed("cached.py").destroy();
+  Script::Create("cached.py", "a = 1\nb = 2\n");
+  quiz_assert(scriptStore.compiledScript("cached.py", &size) == nullptr);
+  assert_script_execution_succeeds(script, "False 2\n");
+
+  ScriptStore::DeleteCompiledScripts();
+  quiz_assert(scriptStore.compiledScript("cached.py", &size) == nullptr);
+  MicroPython::registerScriptProvider(nullptr);
+  ScriptStore::DeleteAllScripts();
+}
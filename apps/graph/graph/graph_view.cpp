@@ -2,6 +2,10 @@
 
 #include <poincare/trigonometry.h>
 
+#if GRAPH_PARALLEL_RENDERING
+#include <poincare/circuit_breaker_checkpoint.h>
+#endif
+
 #include "../app.h"
 
 using namespace Escher;
@@ -33,6 +37,9 @@ void GraphView::drawRect(KDContext *ctx, KDRect rect) const {
     // If the whole curve is redrawn, all points of interest need a redraw
     m_nextPointOfInterestIndex = 0;
   }
+#if GRAPH_PARALLEL_RENDERING
+  fillCachesConcurrently(rect);
+#endif
   FunctionGraphView::drawRect(ctx, rect);
 }
 
@@ -88,34 +95,9 @@ void GraphView::drawRecord(Ion::Storage::Record record, int index,
     }
   }
 
-  ContinuousFunctionCache *cch = functionStore()->cacheAtIndex(index);
-  float tmin = f->tMin();
-  float tmax = f->tMax();
   Axis axis = f->isAlongY() ? Axis::Vertical : Axis::Horizontal;
-  KDCoordinate rectMin = axis == Axis::Horizontal
-                             ? rect.left() - k_externRectMargin
-                             : rect.bottom() + k_externRectMargin;
-  KDCoordinate rectMax = axis == Axis::Horizontal
-                             ? rect.right() + k_externRectMargin
-                             : rect.top() - k_externRectMargin;
-  float tCacheMin, tStep, tCacheStep;
-  if (f->properties().isCartesian()) {
-    float rectLimit = pixelToFloat(axis, rectMin);
-    /* Here, tCacheMin can depend on rect (and change as the user move)
-     * because cache can be panned for cartesian curves, instead of being
-     * entirely invalidated. */
-    tCacheMin = std::isnan(rectLimit) ? tmin : std::max(tmin, rectLimit);
-    tmax = std::min(pixelToFloat(axis, rectMax), tmax);
-    tStep = axis == Axis::Horizontal ? pixelWidth() : pixelHeight();
-    tCacheStep = tStep / 2.;
-  } else {
-    tCacheMin = tmin;
-    // Compute tCacheStep and tStepNonCartesian
-    ContinuousFunctionCache::ComputeNonCartesianSteps(&tStep, &tCacheStep, tmax,
-                                                      tmin);
-  }
-  ContinuousFunctionCache::PrepareForCaching(f.operator->(), cch, tCacheMin,
-                                             tCacheStep);
+  float tCacheMin, tmax, tStep;
+  prepareCache(f.operator->(), index, rect, &tCacheMin, &tmax, &tStep);
 
   /* Check now if e can be discontinuous: In case e does not involves
    * discontinuous functions, this avoids recomputing potential
@@ -145,6 +127,90 @@ void GraphView::drawRecord(Ion::Storage::Record record, int index,
   drawTangent(ctx, rect, record);
 }
 
+void GraphView::prepareCache(ContinuousFunction *f, int index, KDRect rect,
+                             float *tCacheMin, float *tMax,
+                             float *tStep) const {
+  ContinuousFunctionCache *cch = functionStore()->cacheAtIndex(index);
+  float tmin = f->tMin();
+  float tmax = f->tMax();
+  Axis axis = f->isAlongY() ? Axis::Vertical : Axis::Horizontal;
+  KDCoordinate rectMin = axis == Axis::Horizontal
+                             ? rect.left() - k_externRectMargin
+                             : rect.bottom() + k_externRectMargin;
+  KDCoordinate rectMax = axis == Axis::Horizontal
+                             ? rect.right() + k_externRectMargin
+                             : rect.top() - k_externRectMargin;
+  float tCacheStep;
+  if (f->properties().isCartesian()) {
+    float rectLimit = pixelToFloat(axis, rectMin);
+    /* Here, tCacheMin can depend on rect (and change as the user move)
+     * because cache can be panned for cartesian curves, instead of being
+     * entirely invalidated. */
+    *tCacheMin = std::isnan(rectLimit) ? tmin : std::max(tmin, rectLimit);
+    tmax = std::min(pixelToFloat(axis, rectMax), tmax);
+    *tStep = axis == Axis::Horizontal ? pixelWidth() : pixelHeight();
+    tCacheStep = *tStep / 2.;
+  } else {
+    *tCacheMin = tmin;
+    // Compute tCacheStep and tStepNonCartesian
+    ContinuousFunctionCache::ComputeNonCartesianSteps(tStep, &tCacheStep, tmax,
+                                                      tmin);
+  }
+  *tMax = tmax;
+  ContinuousFunctionCache::PrepareForCaching(f, cch, *tCacheMin, tCacheStep);
+}
+
+#if GRAPH_PARALLEL_RENDERING
+void GraphView::fillCachesConcurrently(KDRect rect) const {
+  /* The caches of the curves that can be evaluated with compiled programs are
+   * filled by worker threads before drawing. Everything the workers need is
+   * read here from the records: they only get plain values and the compiled
+   * programs, which stay in the memoized models until they are joined. They
+   * thus neither read the storage nor use the TreePool. Other curves, and the
+   * drawing itself, stay on this thread. */
+  constexpr int k_maxNumberOfWorkers =
+      CachesContainer::k_numberOfAvailableCaches;
+  static_assert(k_maxNumberOfWorkers <=
+                    ContinuousFunctionStore::k_maxNumberOfMemoizedModels,
+                "The models of the filled caches must stay memoized");
+  ContinuousFunctionCache *caches[k_maxNumberOfWorkers];
+  ContinuousFunctionCache::CompiledCurve curves[k_maxNumberOfWorkers];
+  float tMax[k_maxNumberOfWorkers];
+  int numberOfCaches = 0;
+  int n = std::min(numberOfDrawnRecords(), k_maxNumberOfWorkers);
+  for (int i = 0; i < n; i++) {
+    if (functionWasInterrupted(i)) {
+      continue;
+    }
+    Ion::Storage::Record record = initModelBeforeDrawingPlot(i);
+    CircuitBreakerCheckpoint checkpoint(
+        Ion::CircuitBreaker::CheckpointType::Back);
+    if (CircuitBreakerRun(checkpoint)) {
+      ContinuousFunction *f =
+          functionStore()->modelForRecord(record).operator->();
+      if (!f->properties().isEnabled()) {
+        continue;
+      }
+      curves[numberOfCaches] = f->compiledCurve(context());
+      if (!curves[numberOfCaches].isCompiled()) {
+        continue;
+      }
+      float tCacheMin, tStep;
+      prepareCache(f, i, rect, &tCacheMin, tMax + numberOfCaches, &tStep);
+      if (f->cache()) {
+        caches[numberOfCaches++] = f->cache();
+      }
+    } else {
+      setFunctionInterrupted(i);
+      tidyModel(i, checkpoint.endOfPoolBeforeCheckpoint());
+      m_context->tidyDownstreamPoolFrom(checkpoint.endOfPoolBeforeCheckpoint());
+    }
+  }
+  ContinuousFunctionCache::FillConcurrently(caches, curves, tMax,
+                                            numberOfCaches);
+}
+#endif
+
 void GraphView::tidyModel(int i, TreeNode *treePoolCursor) const {
   functionStore()
       ->modelForRecord(functionStore()->activeRecordAtIndex(i))
@@ -165,6 +231,18 @@ static Coordinate2D<T> evaluateXYSecondCurve(T t, void *model, void *context) {
   return reinterpret_cast<ContinuousFunction *>(model)->evaluateXYAtParameter(
       t, reinterpret_cast<Context *>(context), 1);
 }
+static void evaluateXYBatch(const float *t, Coordinate2D<float> *xy,
+                            int numberOfParameters, void *model,
+                            void *context) {
+  reinterpret_cast<ContinuousFunction *>(model)->evaluateXYAtParameters(
+      t, xy, numberOfParameters, reinterpret_cast<Context *>(context), 0);
+}
+static void evaluateXYSecondCurveBatch(const float *t, Coordinate2D<float> *xy,
+                                       int numberOfParameters, void *model,
+                                       void *context) {
+  reinterpret_cast<ContinuousFunction *>(model)->evaluateXYAtParameters(
+      t, xy, numberOfParameters, reinterpret_cast<Context *>(context), 1);
+}
 template <typename T>
 static Coordinate2D<T> evaluateXYFirstDerivative(T t, void *model,
                                                  void *context) {
@@ -217,6 +295,15 @@ GraphView::Curve2DEvaluation<T> GraphView::subCurveEvaluation(
                               : evaluateXYSecondDerivative<T>;
 }
 
+GraphView::Curve2DEvaluationBatch GraphView::subCurveEvaluationBatch(
+    ContinuousFunction *f, int subCurveIndex) const {
+  if (subCurveIndex == 0) {
+    return evaluateXYBatch;
+  }
+  // Derivatives are evaluated one parameter at a time
+  return f->numberOfSubCurves() > 1 ? evaluateXYSecondCurveBatch : nullptr;
+}
+
 void GraphView::drawCartesian(KDContext *ctx, KDRect rect,
                               ContinuousFunction *f,
                               Ion::Storage::Record record, float tStart,
@@ -289,9 +376,10 @@ void GraphView::drawCartesian(KDContext *ctx, KDRect rect,
   int n = f->numberOfSubCurves(true);
   for (int i = n - 1; i >= 0; i--) {
     Curve2DEvaluation<float> evaluationFloat = subCurveEvaluation<float>(f, i);
-    CurveDrawing secondCurve(Curve2D(evaluationFloat, f), context(), tStart,
-                             tEnd, tStep, f->subCurveColor(i), true,
-                             f->properties().plotIsDotted());
+    CurveDrawing secondCurve(
+        Curve2D(evaluationFloat, f, subCurveEvaluationBatch(f, i)), context(),
+        tStart, tEnd, tStep, f->subCurveColor(i), true,
+        f->properties().plotIsDotted());
     Curve2DEvaluation<double> evaluationDouble =
         subCurveEvaluation<double>(f, i);
     secondCurve.setPrecisionOptions(true, evaluationDouble, discontinuity);
@@ -528,8 +616,8 @@ void GraphView::drawFunction(KDContext *ctx, KDRect rect, ContinuousFunction *f,
                              DiscontinuityTest discontinuity) const {
   assert(f->properties().isParametric() || f->properties().isInversePolar() ||
          f->properties().isPolar());
-  CurveDrawing plot(Curve2D(evaluateXY<float>, f), context(), tStart, tEnd,
-                    tStep, f->color());
+  CurveDrawing plot(Curve2D(evaluateXY<float>, f, evaluateXYBatch), context(),
+                    tStart, tEnd, tStep, f->color());
   plot.setPrecisionOptions(false, nullptr, discontinuity);
   plot.draw(this, ctx, rect);
 }
@@ -52,6 +52,12 @@ class GraphView : public Shared::FunctionGraphView,
   Escher::View *ornamentView() const override {
     return const_cast<InterestView *>(&m_interestView);
   }
+  // Compute the sampling range of f in rect and prepare its cache for it
+  void prepareCache(Shared::ContinuousFunction *f, int index, KDRect rect,
+                    float *tCacheMin, float *tMax, float *tStep) const;
+#if GRAPH_PARALLEL_RENDERING
+  void fillCachesConcurrently(KDRect rect) const;
+#endif
   void drawCartesian(KDContext *ctx, KDRect rect, Shared::ContinuousFunction *f,
                      Ion::Storage::Record record, float tMin, float tMax,
                      float tStep, DiscontinuityTest discontinuity,
@@ -75,6 +81,8 @@ class GraphView : public Shared::FunctionGraphView,
   template <typename T>
   Curve2DEvaluation<T> subCurveEvaluation(Shared::ContinuousFunction *f,
                                           int subCurveIndex) const;
+  Curve2DEvaluationBatch subCurveEvaluationBatch(Shared::ContinuousFunction *f,
+                                                 int subCurveIndex) const;
 
   InterestView m_interestView;
   mutable int m_areaIndex;
@@ -157,4 +157,106 @@ QUIZ_CASE(graph_caching) {
   Preferences::SharedPreferences()->setAngleUnit(previousAngleUnit);
 }
 
+void prepare_cache_for_filling(ContinuousFunction* function,
+                               ContinuousFunctionCache* cache, float tMin,
+                               float tMax) {
+  float tStep, tCacheStep;
+  if (function->properties().isCartesian()) {
+    tCacheStep = (tMax - tMin) / (Ion::Display::Width - 1);
+  } else {
+    ContinuousFunctionCache::ComputeNonCartesianSteps(&tStep, &tCacheStep,
+                                                      tMax, tMin);
+  }
+  ContinuousFunctionCache::PrepareForCaching(function, cache, tMin,
+                                             tCacheStep);
+}
+
+void assert_filled_cache_matches_function(ContinuousFunction* function,
+                                          ContinuousFunctionCache* cache,
+                                          Context* context, float tMin,
+                                          float tMax) {
+  // Only compare values that were filled, without computing new ones
+  function->setCache(nullptr);
+  for (int i = 0; i < Ion::Display::Width / 2; i++) {
+    float t = tMin + i * cache->step();
+    if (t > tMax) {
+      break;
+    }
+    Coordinate2D<float> cacheValues =
+        cache->valueForParameter(function, context, t, 0);
+    Coordinate2D<float> functionValues =
+        function->evaluateXYAtParameter(t, context);
+    assert_float_equals(cacheValues.x(), functionValues.x());
+    assert_float_equals(cacheValues.y(), functionValues.y());
+  }
+}
+
+void assert_filled_cache_matches_function(const char* definition,
+                                          float tMin = -5.f, float tMax = 5.f) {
+  GlobalContext globalContext;
+  ContinuousFunctionStore functionStore;
+  CachesContainer cachesContainer;
+  functionStore.setCachesContainer(&cachesContainer);
+  ContinuousFunction* function =
+      addFunction(definition, &functionStore, &globalContext);
+  ContinuousFunctionCache::CompiledCurve curve =
+      function->compiledCurve(&globalContext);
+  quiz_assert(curve.isCompiled());
+
+  ContinuousFunctionCache* cache = functionStore.cacheAtIndex(0);
+  prepare_cache_for_filling(function, cache, tMin, tMax);
+  cache->fillUpTo(curve, tMax);
+  assert_filled_cache_matches_function(function, cache, &globalContext, tMin,
+                                       tMax);
+
+  functionStore.removeAll();
+}
+
+QUIZ_CASE(graph_caching_fill) {
+  assert_filled_cache_matches_function("f(x)=x^2-1");
+  assert_filled_cache_matches_function("f(x)=√(x)");
+  assert_filled_cache_matches_function("f(x)=1/x", -5e-5f, 5e-5f);
+  assert_filled_cache_matches_function("r=cos(5θ)", 0.f, 360.f);
+  assert_filled_cache_matches_function("f(t)=(cos(t),sin(2t))", 0.f, 360.f);
+}
+
+#if GRAPH_HOST_THREADS
+QUIZ_CASE(graph_caching_fill_concurrently) {
+  constexpr int k_numberOfFunctions =
+      CachesContainer::k_numberOfAvailableCaches;
+  constexpr const char* k_definitions[k_numberOfFunctions] = {
+      "f(x)=x^2-1", "g(x)=√(x)", "r=cos(5θ)", "h(t)=(cos(t),sin(2t))",
+      "y=3x+1"};
+  constexpr float k_tMin[k_numberOfFunctions] = {-5.f, -5.f, 0.f, 0.f, -5.f};
+  constexpr float k_tMax[k_numberOfFunctions] = {5.f, 5.f, 360.f, 360.f, 5.f};
+
+  GlobalContext globalContext;
+  ContinuousFunctionStore functionStore;
+  CachesContainer cachesContainer;
+  functionStore.setCachesContainer(&cachesContainer);
+  ContinuousFunction* functions[k_numberOfFunctions];
+  ContinuousFunctionCache* caches[k_numberOfFunctions];
+  ContinuousFunctionCache::CompiledCurve curves[k_numberOfFunctions];
+  for (int i = 0; i < k_numberOfFunctions; i++) {
+    functions[i] =
+        addFunction(k_definitions[i], &functionStore, &globalContext);
+  }
+  for (int i = 0; i < k_numberOfFunctions; i++) {
+    curves[i] = functions[i]->compiledCurve(&globalContext);
+    quiz_assert(curves[i].isCompiled());
+    caches[i] = functionStore.cacheAtIndex(i);
+    prepare_cache_for_filling(functions[i], caches[i], k_tMin[i], k_tMax[i]);
+  }
+
+  ContinuousFunctionCache::FillConcurrently(caches, curves, k_tMax,
+                                            k_numberOfFunctions);
+  for (int i = 0; i < k_numberOfFunctions; i++) {
+    assert_filled_cache_matches_function(functions[i], caches[i],
+                                         &globalContext, k_tMin[i], k_tMax[i]);
+  }
+
+  functionStore.removeAll();
+}
+#endif
+
 }  // namespace Graph
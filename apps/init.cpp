@@ -15,4 +15,10 @@ void Init() {
   ::AppsContainerStorage::sharedAppsContainerStorage.init();
 }
 
+void Shutdown() {
+  ::AppsContainerStorage::sharedAppsContainerStorage.deinit();
+  ::Shared::GlobalContext::continuousFunctionStore.deinit();
+  ::Shared::GlobalContext::sequenceStore.deinit();
+}
+
 }  // namespace Apps
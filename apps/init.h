@@ -4,6 +4,8 @@
 namespace Apps {
 
 void Init();
+// Undo Init, so that it can be called again
+void Shutdown();
 
 }
 
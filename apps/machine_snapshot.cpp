@@ -0,0 +1,138 @@
+#include "machine_snapshot.h"
+
+#if ION_SIMULATOR_FILES
+
+#include <ion.h>
+#include <poincare/tree_pool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "apps_container.h"
+#include "shared/global_context.h"
+
+using Ion::Storage::FileSystem;
+using Poincare::TreePool;
+
+/* File format:
+ *   "NWMS" : Magic
+ * + "XXXXXXXX" : Software version
+ * + "XXXXXXXX" : Patch level, the commit the binary was built from
+ * + 0x01 : Snapshot format version
+ * + Index of the active app, or -1
+ * + Addresses of the code and of the pool, to check the layout of the process
+ * + Storage image
+ * + Objects, in the order of ObjectAtIndex
+ * + Screen pixels */
+
+constexpr static const char* k_magic = "NWMS";
+constexpr static size_t k_magicLength = 4;
+constexpr static size_t k_versionLength = 8;
+constexpr static uint8_t k_formatVersion = 1;
+constexpr static int k_numberOfPixels =
+    Ion::Display::Width * Ion::Display::Height;
+
+struct Header {
+  char magic[k_magicLength];
+  char version[k_versionLength];
+  char patchLevel[k_versionLength];
+  uint8_t formatVersion;
+  int8_t activeAppIndex;
+  uint64_t codeAddress;
+  uint64_t poolAddress;
+};
+
+static void InitHeader(Header* header, int activeAppIndex) {
+  memset(header, 0, sizeof(Header));
+  memcpy(header->magic, k_magic, k_magicLength);
+  strncpy(header->version, Ion::epsilonVersion(), k_versionLength);
+  strncpy(header->patchLevel, Ion::patchLevel(), k_versionLength);
+  header->formatVersion = k_formatVersion;
+  header->activeAppIndex = activeAppIndex;
+  header->codeAddress = reinterpret_cast<uintptr_t>(&MachineSnapshot::Save);
+  header->poolAddress = reinterpret_cast<uintptr_t>(TreePool::sharedPool.get());
+}
+
+// Objects saved as they are, the app snapshots come last
+constexpr static int k_numberOfObjectsBeforeAppSnapshots = 3;
+
+static int NumberOfObjects() {
+  return k_numberOfObjectsBeforeAppSnapshots +
+         AppsContainer::sharedAppsContainer()->numberOfBuiltinApps();
+}
+
+static void ObjectAtIndex(int index, void** address, size_t* size) {
+  switch (index) {
+    case 0:
+      *address = TreePool::sharedPool.get();
+      *size = sizeof(TreePool);
+      return;
+    case 1:
+      *address = Shared::GlobalContext::continuousFunctionStore.get();
+      *size = sizeof(Shared::ContinuousFunctionStore);
+      return;
+    case 2:
+      *address = Shared::GlobalContext::sequenceStore.get();
+      *size = sizeof(Shared::SequenceStore);
+      return;
+    default:
+      AppsContainer::sharedAppsContainer()->appSnapshotBytesAtIndex(
+          index - k_numberOfObjectsBeforeAppSnapshots, address, size);
+  }
+}
+
+static KDColor s_pixels[k_numberOfPixels];
+
+bool MachineSnapshot::Save(const char* filename, int activeAppIndex) {
+  FILE* f = fopen(filename, "wb");
+  if (f == nullptr) {
+    return false;
+  }
+  Header header;
+  InitHeader(&header, activeAppIndex);
+  bool result =
+      fwrite(&header, sizeof(header), 1, f) == 1 &&
+      fwrite(FileSystem::sharedFileSystem->image(), FileSystem::k_imageSize, 1,
+             f) == 1;
+  for (int i = 0; result && i < NumberOfObjects(); i++) {
+    void* address;
+    size_t size;
+    ObjectAtIndex(i, &address, &size);
+    result = fwrite(address, size, 1, f) == 1;
+  }
+  Ion::Display::pullRect(KDRectScreen, s_pixels);
+  result = result && fwrite(s_pixels, sizeof(s_pixels), 1, f) == 1;
+  fclose(f);
+  return result;
+}
+
+bool MachineSnapshot::Load(const char* filename, int* activeAppIndex) {
+  FILE* f = fopen(filename, "rb");
+  if (f == nullptr) {
+    return false;
+  }
+  Header header, expectedHeader;
+  static char s_image[FileSystem::k_imageSize];
+  bool result = fread(&header, sizeof(header), 1, f) == 1;
+  InitHeader(&expectedHeader, header.activeAppIndex);
+  result = result && memcmp(&header, &expectedHeader, sizeof(Header)) == 0 &&
+           fread(s_image, sizeof(s_image), 1, f) == 1 &&
+           FileSystem::sharedFileSystem->loadImage(s_image);
+  /* The storage was restored first, so that the stores forget the records
+   * they cached while they still point to nodes of this pool. */
+  for (int i = 0; result && i < NumberOfObjects(); i++) {
+    void* address;
+    size_t size;
+    ObjectAtIndex(i, &address, &size);
+    result = fread(address, size, 1, f) == 1;
+  }
+  result = result && fread(s_pixels, sizeof(s_pixels), 1, f) == 1;
+  fclose(f);
+  if (!result) {
+    return false;
+  }
+  Ion::Display::pushRect(KDRectScreen, s_pixels);
+  *activeAppIndex = header.activeAppIndex;
+  return true;
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef APPS_MACHINE_SNAPSHOT_H
+#define APPS_MACHINE_SNAPSHOT_H
+
+#if ION_SIMULATOR_FILES
+
+/* A machine snapshot saves the state a simulator run ends in, so that other
+ * runs can start from it instead of replaying the events that led to it. It is
+ * taken once the active app has been packed into its snapshot, like when the
+ * user goes back home, and holds:
+ * - the storage, which includes the global and Poincare preferences,
+ * - the Poincare pool, the function and sequence stores,
+ * - the snapshots of the builtin apps and the index of the active one,
+ * - the content of the screen.
+ * All but the storage are saved as the bytes of their objects, which hold
+ * pointers. A machine snapshot is thus only valid for the binary that saved
+ * it, run without address space randomization. */
+
+class MachineSnapshot {
+ public:
+  constexpr static int k_noApp = -1;
+
+  static bool Save(const char* filename, int activeAppIndex);
+  // On success, activeAppIndex is set to the app the snapshot was saved in
+  static bool Load(const char* filename, int* activeAppIndex);
+};
+
+#endif
+
+#endif
@@ -1,9 +1,14 @@
 #include <escher/init.h>
+#include <escher/redraw_telemetry.h>
 #include <poincare/init.h>
+#include <poincare/print.h>
+#include <poincare/tree_pool.h>
 
 #include "apps_container.h"
+#include "benchmark.h"
 #include "global_preferences.h"
 #include "init.h"
+#include "machine_snapshot.h"
 
 #define DUMMY_MAIN 0
 #if DUMMY_MAIN
@@ -34,17 +39,113 @@ void ion_main(int argc, const char* const argv[]) {
 
 #else
 
+#if POINCARE_POOL_TELEMETRY
+static void printPoolTelemetry() {
+  using Poincare::TreePool;
+  constexpr int k_bufferSize = 64;
+  char buffer[k_bufferSize];
+  const TreePool::Telemetry &telemetry = TreePool::sharedPool->telemetry();
+  Poincare::Print::CustomPrintf(buffer, k_bufferSize,
+                                "POOL PEAK: %i/%i bytes",
+                                static_cast<int>(telemetry.peakSize),
+                                TreePool::Size());
+  Ion::Console::writeLine(buffer);
+  Poincare::Print::CustomPrintf(buffer, k_bufferSize, "POOL RAISES: %i",
+                                telemetry.numberOfRaises);
+  Ion::Console::writeLine(buffer);
+  for (int i = 0; i < TreePool::Telemetry::k_numberOfTypes; i++) {
+    if (telemetry.numberOfExpressions[i] > 0) {
+      Poincare::Print::CustomPrintf(buffer, k_bufferSize,
+                                    "POOL NODES OF TYPE %i: %i", i,
+                                    telemetry.numberOfExpressions[i]);
+      Ion::Console::writeLine(buffer);
+    }
+  }
+  Poincare::Print::CustomPrintf(buffer, k_bufferSize,
+                                "POOL OTHER NODES: %i",
+                                telemetry.numberOfOtherNodes);
+  Ion::Console::writeLine(buffer);
+}
+#endif
+
 void ion_main(int argc, const char *const argv[]) {
   // Initialize Poincare::TreePool::sharedPool
   Poincare::Init();
   Escher::Init();
   Apps::Init();
 
+#if POINCARE_POOL_TELEMETRY
+  bool poolTelemetry = false;
+#endif
+#if ION_SIMULATOR_FILES
+  bool snapshotLoaded = true;
+  const char *benchmarkReport = nullptr;
+  const char *benchmarkScenario = "";
+#endif
+#if ION_SIMULATOR_FILES && ESCHER_REDRAW_TELEMETRY
+  const char *redrawReport = nullptr;
+#endif
 #if EPSILON_GETOPT
   for (int i = 1; i < argc; i++) {
     if (argv[i][0] != '-' || argv[i][1] != '-') {
       continue;
     }
+#if ION_SIMULATOR_FILES
+    /* Option to start from the state a previous run was saved in, the options
+     * that follow can override it:
+     * $ ./epsilon.elf --load-snapshot graph.nwms */
+    if (strcmp(argv[i], "--load-snapshot") == 0 && argc > i + 1) {
+      int appIndex;
+      if (!MachineSnapshot::Load(argv[i + 1], &appIndex)) {
+        Ion::Console::writeLine("Error loading the machine snapshot");
+        snapshotLoaded = false;
+        break;
+      }
+      if (appIndex != MachineSnapshot::k_noApp &&
+          appIndex <
+              AppsContainer::sharedAppsContainer()->numberOfBuiltinApps()) {
+        AppsContainer::sharedAppsContainer()->setInitialAppSnapshot(
+            AppsContainer::sharedAppsContainer()->appSnapshotAtIndex(
+                appIndex));
+      }
+      continue;
+    }
+    /* Option to save the state of the simulator when it terminates:
+     * $ ./epsilon.elf --headless -l graph.nws --save-snapshot graph.nwms */
+    if (strcmp(argv[i], "--save-snapshot") == 0 && argc > i + 1) {
+      AppsContainer::sharedAppsContainer()->setMachineSnapshotFilename(
+          argv[i + 1]);
+      continue;
+    }
+    /* Option to report the cost of each dispatched event, the simulator names
+     * the scenario after the state file:
+     * $ ./epsilon.elf --headless -l graph.nws --benchmark report.jsonl */
+    if (strcmp(argv[i], "--benchmark") == 0 && argc > i + 1) {
+      benchmarkReport = argv[i + 1];
+      continue;
+    }
+    if (strcmp(argv[i], "--benchmark-scenario") == 0 && argc > i + 1) {
+      benchmarkScenario = argv[i + 1];
+      continue;
+    }
+#if ESCHER_REDRAW_TELEMETRY
+    /* Option to report which views each event redraws and who dirtied them,
+     * to a file or to the console with "-":
+     * $ ./epsilon.elf --headless -l graph.nws --redraw-telemetry - */
+    if (strcmp(argv[i], "--redraw-telemetry") == 0 && argc > i + 1) {
+      redrawReport = argv[i + 1];
+      continue;
+    }
+#endif
+#endif
+#if POINCARE_POOL_TELEMETRY
+    /* Option to print the pool usage on exit, by expression type:
+     * $ ./epsilon.elf --headless --pool-telemetry < events.txt */
+    if (strcmp(argv[i], "--pool-telemetry") == 0) {
+      poolTelemetry = true;
+      continue;
+    }
+#endif
     /* Option should be given at run-time:
      * $ ./epsilon.elf --language fr */
     if (strcmp(argv[i], "--language") == 0 && argc > i + 1) {
@@ -107,7 +208,40 @@ void ion_main(int argc, const char *const argv[]) {
   volatile int stackTop;
   Ion::setStackStart((void *)(&stackTop));
 
+#if ION_SIMULATOR_FILES
+  /* A snapshot that failed to load may have overwritten some objects already,
+   * the apps do not run on them but are still shut down below. */
+  if (snapshotLoaded) {
+    if (benchmarkReport &&
+        !Benchmark::Start(benchmarkReport, benchmarkScenario)) {
+      Ion::Console::writeLine("Error opening the benchmark report");
+    }
+#if ESCHER_REDRAW_TELEMETRY
+    if (redrawReport && !Escher::RedrawTelemetry::SharedTelemetry()->start(
+                            redrawReport, benchmarkScenario)) {
+      Ion::Console::writeLine("Error opening the redraw telemetry report");
+    }
+#endif
+    AppsContainer::sharedAppsContainer()->run();
+    Benchmark::Stop();
+#if ESCHER_REDRAW_TELEMETRY
+    Escher::RedrawTelemetry::SharedTelemetry()->stop();
+#endif
+  }
+#else
   AppsContainer::sharedAppsContainer()->run();
+#endif
+#if POINCARE_POOL_TELEMETRY
+  if (poolTelemetry) {
+    printPoolTelemetry();
+  }
+#endif
+#if ION_SIMULATOR_FILES
+  // The simulator can run ion_main again, for the next state file of a batch
+  Apps::Shutdown();
+  Escher::Shutdown();
+  Poincare::Shutdown();
+#endif
 }
 
 #endif
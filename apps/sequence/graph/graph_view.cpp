@@ -22,16 +22,31 @@ void GraphView::drawRecord(Ion::Storage::Record record, int index,
   int xMin = static_cast<int>(std::ceil(range()->xMin())) - 1;
   int xMax = static_cast<int>(std::floor(range()->xMax()));
   int x = xMin;
-  while ((x = nextDotIndex(s, x)) <= xMax) {
-    float y = s->evaluateXYAtParameter(static_cast<float>(x), context()).y();
-    if (std::isnan(y)) {
-      continue;
+  // Ranks are evaluated by batches, in increasing order
+  constexpr int k_batchSize = 16;
+  float ranks[k_batchSize];
+  Coordinate2D<float> dots[k_batchSize];
+  bool isLastBatch = false;
+  while (!isLastBatch) {
+    int numberOfRanks = 0;
+    while (numberOfRanks < k_batchSize && (x = nextDotIndex(s, x)) <= xMax) {
+      ranks[numberOfRanks++] = static_cast<float>(x);
     }
-    drawDot(ctx, rect, Dots::Size::Tiny, Coordinate2D<float>(x, y), s->color());
-    if (x >= m_highlightedStart && x <= m_highlightedEnd &&
-        record == m_selectedRecord) {
-      KDColor color = m_shouldColorHighlighted ? s->color() : KDColorBlack;
-      drawStraightSegment(ctx, rect, Axis::Vertical, x, y, 0.f, color);
+    isLastBatch = numberOfRanks < k_batchSize;
+    s->evaluateXYAtParameters(ranks, dots, numberOfRanks, context());
+    for (int i = 0; i < numberOfRanks; i++) {
+      float rank = ranks[i];
+      float y = dots[i].y();
+      if (std::isnan(y)) {
+        continue;
+      }
+      drawDot(ctx, rect, Dots::Size::Tiny, Coordinate2D<float>(rank, y),
+              s->color());
+      if (rank >= m_highlightedStart && rank <= m_highlightedEnd &&
+          record == m_selectedRecord) {
+        KDColor color = m_shouldColorHighlighted ? s->color() : KDColorBlack;
+        drawStraightSegment(ctx, rect, Axis::Vertical, rank, y, 0.f, color);
+      }
     }
   }
 }
@@ -709,6 +709,30 @@ QUIZ_CASE(sequence_context) {
   store->tidyDownstreamPoolFrom();
 }
 
+QUIZ_CASE(sequence_context_initial_rank) {
+  Shared::GlobalContext globalContext;
+  SequenceStore* store = globalContext.sequenceStore;
+  Sequence* u = addSequence(store, Sequence::Type::Explicit, "n", nullptr,
+                            nullptr, globalContext.sequenceContext());
+  assert_expression_simplifies_approximates_to<double>("u(5)", "5");
+  /* The rank is written in place in the record, the memoized reductions of
+   * u(5) must not be reused afterwards. */
+  uint32_t version = globalContext.versionForReductionCache();
+  u->setInitialRank(6);
+  quiz_assert(globalContext.versionForReductionCache() != version);
+  assert_expression_simplifies_approximates_to<double>("u(5)", "undef");
+  version = globalContext.versionForReductionCache();
+  u->setInitialRank(0);
+  quiz_assert(globalContext.versionForReductionCache() != version);
+  assert_expression_simplifies_approximates_to<double>("u(5)", "5");
+  version = globalContext.versionForReductionCache();
+  u->setType(Sequence::Type::SingleRecurrence);
+  quiz_assert(globalContext.versionForReductionCache() != version);
+
+  store->removeAll();
+  store->tidyDownstreamPoolFrom();
+}
+
 QUIZ_CASE(sequence_order) {
   Shared::GlobalContext globalContext;
   SequenceStore* store = globalContext.sequenceStore;
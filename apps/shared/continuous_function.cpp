@@ -275,10 +275,12 @@ void ContinuousFunction::updateDerivativeColorAfterChangingPlotDisplay(
       newDisplay ? GlobalContext::continuousFunctionStore->colorForNewModel()
                  : color();
   recordData()->setColor(newColor, derivationOrder);
+  DidChangeRecordData();
 }
 
 void ContinuousFunction::setDisplayValueFirstDerivative(bool display) {
   recordData()->setDisplayValueFirstDerivative(display);
+  DidChangeRecordData();
 }
 
 void ContinuousFunction::setDisplayPlotFirstDerivative(bool display) {
@@ -287,6 +289,7 @@ void ContinuousFunction::setDisplayPlotFirstDerivative(bool display) {
   bool previousDisplay = recordData()->displayPlotFirstDerivative();
   recordData()->setDisplayPlotFirstDerivative(display);
   recordData()->setDisplayValueFirstDerivative(display);
+  DidChangeRecordData();
   if (previousDisplay != display) {
     updateDerivativeColorAfterChangingPlotDisplay(display, 1);
   }
@@ -294,6 +297,7 @@ void ContinuousFunction::setDisplayPlotFirstDerivative(bool display) {
 
 void ContinuousFunction::setDisplayValueSecondDerivative(bool display) {
   recordData()->setDisplayValueSecondDerivative(display);
+  DidChangeRecordData();
 }
 
 void ContinuousFunction::setDisplayPlotSecondDerivative(bool display) {
@@ -302,6 +306,7 @@ void ContinuousFunction::setDisplayPlotSecondDerivative(bool display) {
   bool previousDisplay = recordData()->displayPlotSecondDerivative();
   recordData()->setDisplayPlotSecondDerivative(display);
   recordData()->setDisplayValueSecondDerivative(display);
+  DidChangeRecordData();
   if (previousDisplay != display) {
     updateDerivativeColorAfterChangingPlotDisplay(display, 2);
   }
@@ -423,12 +428,14 @@ double ContinuousFunction::approximateSlope(double t,
 void ContinuousFunction::setTMin(float tMin) {
   assert(!recordData()->tAuto());
   recordData()->setTMin(tMin);
+  DidChangeRecordData();
   setCache(nullptr);
 }
 
 void ContinuousFunction::setTMax(float tMax) {
   assert(!recordData()->tAuto());
   recordData()->setTMax(tMax);
+  DidChangeRecordData();
   setCache(nullptr);
 }
 
@@ -439,6 +446,7 @@ void ContinuousFunction::setTAuto(bool tAuto) {
   /* Domain either was or will be auto. Reset values anyway in case model has
    * been updated or angle unit changed. */
   recordData()->setTAuto(tAuto);
+  DidChangeRecordData();
   setCache(nullptr);
   if (tAuto) {
     // No need to update Tmin or Tmax since the auto value will be returned
@@ -508,9 +516,56 @@ float ContinuousFunction::rangeStep() const {
 template <typename T>
 Coordinate2D<T> ContinuousFunction::privateEvaluateXYAtParameter(
     T t, Context *context, int subCurveIndex) const {
+  return xyFromApproximation(
+      templatedApproximateAtParameter(t, context, subCurveIndex));
+}
+
+ContinuousFunctionCache::CompiledCurve ContinuousFunction::compiledCurve(
+    Context *context, int subCurveIndex) const {
+  ContinuousFunctionProperties thisProperties = properties();
+  ContinuousFunctionCache::CompiledCurve curve = {
+      .x1 = nullptr,
+      .x2 = nullptr,
+      .tMin = tMin(),
+      .tMax = tMax(),
+      .piInAngleUnit = Trigonometry::PiInAngleUnit(
+          Poincare::Preferences::SharedPreferences()->angleUnit()),
+      .isCartesian = thisProperties.isCartesian(),
+      .isAlongY = thisProperties.isAlongY(),
+      .isPolar = thisProperties.isPolar(),
+      .isInversePolar = thisProperties.isInversePolar()};
+  /* The abscissa program is only needed for parametric curves, other curves
+   * only compile their ordinate. */
+  if (derivationOrderFromSubCurveIndex(subCurveIndex) == 0 &&
+      !thisProperties.isScatterPlot()) {
+    if (thisProperties.isParametric()) {
+      curve.x1 = &m_model.compiledApproximation(this, context, 0);
+      curve.x2 = &m_model.compiledApproximation(this, context, 1);
+    } else {
+      curve.x2 = &m_model.compiledApproximation(this, context, subCurveIndex);
+    }
+  }
+  return curve;
+}
+
+void ContinuousFunction::privateEvaluateXYAtParameters(
+    const float *t, Coordinate2D<float> *xy, int numberOfParameters,
+    Context *context, int subCurveIndex) const {
+  ContinuousFunctionCache::CompiledCurve curve =
+      compiledCurve(context, subCurveIndex);
+  if (curve.isCompiled()) {
+    curve.evaluateXYAtParameters(t, xy, numberOfParameters);
+    return;
+  }
+  for (int i = 0; i < numberOfParameters; i++) {
+    xy[i] = privateEvaluateXYAtParameter(t[i], context, subCurveIndex);
+  }
+}
+
+template <typename T>
+Coordinate2D<T> ContinuousFunction::xyFromApproximation(
+    Coordinate2D<T> x1x2) const {
   ContinuousFunctionProperties thisProperties = properties();
-  Coordinate2D<T> x1x2 =
-      templatedApproximateAtParameter(t, context, subCurveIndex);
   if (thisProperties.isParametric() || thisProperties.isCartesian() ||
       thisProperties.isScatterPlot()) {
     return x1x2;
@@ -557,13 +612,22 @@ Coordinate2D<T> ContinuousFunction::templatedApproximateAtParameter(
   }
 
   if (!properties().isParametric()) {
-    if (numberOfSubCurves() >= 2) {
-      assert(derivationOrder == 0);
-      assert(e.numberOfChildren() > subCurveIndex);
-      e = e.childAtIndex(subCurveIndex);
-    }
-    T value = e.approximateToScalarWithValueForSymbol(k_unknownName, t,
+    const CompiledApproximation *compiled =
+        derivationOrder == 0
+            ? &m_model.compiledApproximation(this, context, subCurveIndex)
+            : nullptr;
+    T value;
+    if (compiled && compiled->isCompiled()) {
+      value = compiled->approximateToScalar(t);
+    } else {
+      if (numberOfSubCurves() >= 2) {
+        assert(derivationOrder == 0);
+        assert(e.numberOfChildren() > subCurveIndex);
+        e = e.childAtIndex(subCurveIndex);
+      }
+      value = e.approximateToScalarWithValueForSymbol(k_unknownName, t,
                                                       approximationContext);
+    }
     if (isAlongY()) {
       // Invert x and y with vertical lines so it can be scrolled vertically
       return Coordinate2D<T>(value, t);
@@ -578,6 +642,14 @@ Coordinate2D<T> ContinuousFunction::templatedApproximateAtParameter(
   }
   assert(e.type() == ExpressionNode::Type::Point);
   assert(e.numberOfChildren() == 2);
+  const CompiledApproximation &compiledX =
+      m_model.compiledApproximation(this, context, 0);
+  const CompiledApproximation &compiledY =
+      m_model.compiledApproximation(this, context, 1);
+  if (compiledX.isCompiled() && compiledY.isCompiled()) {
+    return Coordinate2D<T>(compiledX.approximateToScalar(t),
+                           compiledY.approximateToScalar(t));
+  }
   return Coordinate2D<T>(
       e.childAtIndex(0).approximateToScalarWithValueForSymbol(
           k_unknownName, t, approximationContext),
@@ -797,10 +869,40 @@ Poincare::Expression ContinuousFunction::Model::expressionApproximated(
          .target = ReductionTarget::SystemForApproximation,
          .symbolicComputation = SymbolicComputation::DoNotReplaceAnySymbol});
     *approximated = e;
+    if (derivationOrder == 0) {
+      for (CompiledApproximation &compiled : m_compiledApproximations) {
+        compiled.reset();
+      }
+    }
   }
   return *approximated;
 }
 
+const CompiledApproximation &ContinuousFunction::Model::compiledApproximation(
+    const Ion::Storage::Record *record, Context *context, int index) const {
+  assert(0 <= index && index < k_numberOfCompiledApproximations);
+  CompiledApproximation *compiled = m_compiledApproximations + index;
+  ApproximationContext approximationContext(context,
+                                            complexFormat(record, context));
+  if (compiled->isValidFor(approximationContext)) {
+    return *compiled;
+  }
+  Expression e = expressionApproximated(record, context);
+  if (properties(record).isParametric()) {
+    if (e.type() == ExpressionNode::Type::Dependency) {
+      e = e.childAtIndex(0);
+    }
+    e = e.type() == ExpressionNode::Type::Point ? e.childAtIndex(index)
+                                                : Expression();
+  } else if (numberOfSubCurves(record) >= 2) {
+    e = e.childAtIndex(index);
+  } else if (index > 0) {
+    e = Expression();
+  }
+  compiled->compile(e, k_unknownName, approximationContext);
+  return *compiled;
+}
+
 Poincare::Expression ContinuousFunction::Model::expressionReducedForAnalysis(
     const Ion::Storage::Record *record, Poincare::Context *context) const {
   ContinuousFunctionProperties::SymbolType computedFunctionSymbol =
@@ -1157,6 +1259,9 @@ void ContinuousFunction::Model::tidyDownstreamPoolFrom(
   if (treePoolCursor == nullptr ||
       m_expressionApproximated.isDownstreamOf(treePoolCursor)) {
     m_expressionApproximated = Expression();
+    for (CompiledApproximation &compiled : m_compiledApproximations) {
+      compiled.reset();
+    }
   }
   ExpressionModel::tidyDownstreamPoolFrom(treePoolCursor);
 }
@@ -11,6 +11,7 @@
 
 #include <apps/i18n.h>
 #include <poincare/comparison.h>
+#include <poincare/compiled_approximation.h>
 #include <poincare/conic.h>
 #include <poincare/preferences.h>
 #include <poincare/symbol_abstract.h>
@@ -151,6 +152,24 @@ class ContinuousFunction : public Function {
       double t, Poincare::Context *context, int curveIndex = 0) const override {
     return privateEvaluateXYAtParameter<double>(t, context, curveIndex);
   }
+  void evaluateXYAtParameters(const float *t,
+                              Poincare::Coordinate2D<float> *xy,
+                              int numberOfParameters,
+                              Poincare::Context *context,
+                              int curveIndex = 0) const override {
+    if (m_cache) {
+      m_cache->valuesForParameters(this, context, t, xy, numberOfParameters,
+                                   curveIndex);
+    } else {
+      privateEvaluateXYAtParameters(t, xy, numberOfParameters, context,
+                                    curveIndex);
+    }
+  }
+  /* Read the values needed to evaluate a curve with compiled programs,
+   * compiling them if needed. The result can be evaluated without the record
+   * as long as this function is not modified. */
+  ContinuousFunctionCache::CompiledCurve compiledCurve(
+      Poincare::Context *context, int subCurveIndex = 0) const;
   template <typename T>
   Poincare::Coordinate2D<T> evaluateXYDerivativeAtParameter(
       T t, Poincare::Context *context, int derivationOrder) const {
@@ -299,6 +318,15 @@ class ContinuousFunction : public Function {
   template <typename T>
   Poincare::Coordinate2D<T> privateEvaluateXYAtParameter(
       T t, Poincare::Context *context, int subCurveIndex = 0) const;
+  void privateEvaluateXYAtParameters(const float *t,
+                                     Poincare::Coordinate2D<float> *xy,
+                                     int numberOfParameters,
+                                     Poincare::Context *context,
+                                     int subCurveIndex = 0) const;
+  // Convert the approximation to XY (for Polar types)
+  template <typename T>
+  Poincare::Coordinate2D<T> xyFromApproximation(
+      Poincare::Coordinate2D<T> x1x2) const;
   // Approximate XY at parameter
   template <typename T>
   Poincare::Coordinate2D<T> templatedApproximateAtParameter(
@@ -403,6 +431,11 @@ class ContinuousFunction : public Function {
     Poincare::Expression expressionApproximated(
         const Ion::Storage::Record *record, Poincare::Context *context,
         int derivationOrder = 0) const;
+    /* Return the program compiled from expressionApproximated. index is the
+     * subcurve index for conics, or the coordinate for parametric curves. */
+    const Poincare::CompiledApproximation &compiledApproximation(
+        const Ion::Storage::Record *record, Poincare::Context *context,
+        int index) const;
     // Return the expression reduced, and computes plotType
     Poincare::Expression expressionReducedForAnalysis(
         const Ion::Storage::Record *record, Poincare::Context *context) const;
@@ -461,6 +494,11 @@ class ContinuousFunction : public Function {
      * interest.
      */
     mutable Poincare::Expression m_expressionApproximated;
+    /* m_compiledApproximations are flat programs evaluating (subcurves of)
+     * m_expressionApproximated, and are reset along with it. */
+    constexpr static int k_numberOfCompiledApproximations = 2;
+    mutable Poincare::CompiledApproximation
+        m_compiledApproximations[k_numberOfCompiledApproximations];
     mutable Poincare::Expression m_expressionFirstDerivate;
     mutable Poincare::Expression m_expressionFirstDerivateApproximated;
     mutable Poincare::Expression m_expressionSecondDerivate;
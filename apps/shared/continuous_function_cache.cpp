@@ -3,6 +3,10 @@
 #include <limits.h>
 #include <omg/signaling_nan.h>
 
+#if GRAPH_HOST_THREADS
+#include <thread>
+#endif
+
 #include "continuous_function.h"
 
 namespace Shared {
@@ -58,13 +62,149 @@ void ContinuousFunctionCache::clear() {
 Poincare::Coordinate2D<float> ContinuousFunctionCache::valueForParameter(
     const ContinuousFunction *function, Poincare::Context *context, float t,
     int curveIndex) {
-  int resIndex = indexForParameter(function, t, curveIndex);
+  int resIndex =
+      indexForParameter(function->properties().isCartesian(), t, curveIndex);
   if (resIndex < 0) {
     return function->privateEvaluateXYAtParameter(t, context, curveIndex);
   }
   return valuesAtIndex(function, context, t, resIndex, curveIndex);
 }
 
+void ContinuousFunctionCache::valuesForParameters(
+    const ContinuousFunction *function, Poincare::Context *context,
+    const float *t, Poincare::Coordinate2D<float> *xy, int numberOfParameters,
+    int curveIndex) {
+  /* Parameters missing from the cache are gathered, to be evaluated at once
+   * by the function. */
+  constexpr int k_batchSize = 16;
+  float missingT[k_batchSize];
+  Poincare::Coordinate2D<float> missingXY[k_batchSize];
+  int missingIndexes[k_batchSize];
+  int missingCacheIndexes[k_batchSize];
+  int numberOfMissing = 0;
+  bool isCartesian = function->properties().isCartesian();
+  for (int i = 0; i <= numberOfParameters; i++) {
+    if (numberOfMissing == k_batchSize ||
+        (i == numberOfParameters && numberOfMissing > 0)) {
+      function->privateEvaluateXYAtParameters(missingT, missingXY,
+                                              numberOfMissing, context,
+                                              curveIndex);
+      for (int j = 0; j < numberOfMissing; j++) {
+        xy[missingIndexes[j]] = missingXY[j];
+        if (missingCacheIndexes[j] >= 0) {
+          setValuesAtIndex(isCartesian, missingCacheIndexes[j], missingXY[j]);
+        }
+      }
+      numberOfMissing = 0;
+    }
+    if (i == numberOfParameters) {
+      break;
+    }
+    int cacheIndex = indexForParameter(isCartesian, t[i], curveIndex);
+    if (cacheIndex >= 0 && hasValuesAtIndex(isCartesian, cacheIndex)) {
+      xy[i] = cachedValuesAtIndex(isCartesian, t[i], cacheIndex);
+      continue;
+    }
+    missingT[numberOfMissing] = t[i];
+    missingIndexes[numberOfMissing] = i;
+    missingCacheIndexes[numberOfMissing] = cacheIndex;
+    numberOfMissing++;
+  }
+}
+
+void ContinuousFunctionCache::fillUpTo(const CompiledCurve &curve,
+                                       float tMax) {
+  assert(m_tStep > 0.f && curve.isCompiled());
+  constexpr int k_batchSize = 16;
+  float t[k_batchSize];
+  Poincare::Coordinate2D<float> xy[k_batchSize];
+  int cacheIndexes[k_batchSize];
+  int numberOfValues =
+      curve.isCartesian ? k_sizeOfCache : k_sizeOfCache / 2;
+  int numberOfMissing = 0;
+  for (int i = 0; i <= numberOfValues; i++) {
+    float ti = m_tMin + i * m_tStep;
+    bool isLast = i == numberOfValues || ti > tMax;
+    if (!isLast) {
+      int cacheIndex = indexForParameter(curve.isCartesian, ti, 0);
+      if (cacheIndex >= 0 && !hasValuesAtIndex(curve.isCartesian, cacheIndex)) {
+        t[numberOfMissing] = ti;
+        cacheIndexes[numberOfMissing] = cacheIndex;
+        numberOfMissing++;
+      }
+    }
+    if (numberOfMissing == k_batchSize || (isLast && numberOfMissing > 0)) {
+      curve.evaluateXYAtParameters(t, xy, numberOfMissing);
+      for (int j = 0; j < numberOfMissing; j++) {
+        setValuesAtIndex(curve.isCartesian, cacheIndexes[j], xy[j]);
+      }
+      numberOfMissing = 0;
+    }
+    if (isLast) {
+      return;
+    }
+  }
+}
+
+#if GRAPH_HOST_THREADS
+void ContinuousFunctionCache::FillConcurrently(
+    ContinuousFunctionCache *const *caches, const CompiledCurve *curves,
+    const float *tMax, int numberOfCaches) {
+  constexpr int k_maxNumberOfWorkers =
+      CachesContainer::k_numberOfAvailableCaches;
+  assert(numberOfCaches <= k_maxNumberOfWorkers);
+  std::thread workers[k_maxNumberOfWorkers];
+  for (int i = 1; i < numberOfCaches; i++) {
+    workers[i] = std::thread(&ContinuousFunctionCache::fillUpTo, caches[i],
+                             std::cref(curves[i]), tMax[i]);
+  }
+  if (numberOfCaches > 0) {
+    caches[0]->fillUpTo(curves[0], tMax[0]);
+  }
+  for (int i = 1; i < numberOfCaches; i++) {
+    workers[i].join();
+  }
+}
+#endif
+
+void ContinuousFunctionCache::CompiledCurve::evaluateXYAtParameters(
+    const float *t, Poincare::Coordinate2D<float> *xy,
+    int numberOfParameters) const {
+  assert(isCompiled());
+  constexpr int k_batchSize = 16;
+  float x1Values[k_batchSize], x2Values[k_batchSize];
+  for (int i = 0; i < numberOfParameters; i += k_batchSize) {
+    int batchSize = std::min(numberOfParameters - i, k_batchSize);
+    x2->approximateToScalars(t + i, x2Values, batchSize);
+    if (x1) {
+      x1->approximateToScalars(t + i, x1Values, batchSize);
+    }
+    /* Mirror ContinuousFunction::templatedApproximateAtParameter and
+     * xyFromApproximation on each parameter */
+    for (int j = 0; j < batchSize; j++) {
+      float tj = t[i + j];
+      Poincare::Coordinate2D<float> x1x2;
+      if (tj < tMin || tj > tMax) {
+        x1x2 = Poincare::Coordinate2D<float>(isCartesian ? tj : NAN, NAN);
+      } else if (x1) {
+        x1x2 = Poincare::Coordinate2D<float>(x1Values[j], x2Values[j]);
+      } else if (isAlongY) {
+        x1x2 = Poincare::Coordinate2D<float>(x2Values[j], tj);
+      } else {
+        x1x2 = Poincare::Coordinate2D<float>(tj, x2Values[j]);
+      }
+      if (isPolar || isInversePolar) {
+        const float r = isPolar ? x1x2.y() : x1x2.x();
+        const float angle =
+            (isPolar ? x1x2.x() : x1x2.y()) * M_PI / piInAngleUnit;
+        x1x2 = Poincare::Coordinate2D<float>(r * std::cos(angle),
+                                             r * std::sin(angle));
+      }
+      xy[i + j] = x1x2;
+    }
+  }
+}
+
 void ContinuousFunctionCache::ComputeNonCartesianSteps(float *tStep,
                                                        float *tCacheStep,
                                                        float tMax, float tMin) {
@@ -104,8 +244,8 @@ void ContinuousFunctionCache::setRange(float tMin, float tStep) {
   m_tStep = tStep;
 }
 
-int ContinuousFunctionCache::indexForParameter(
-    const ContinuousFunction *function, float t, int curveIndex) const {
+int ContinuousFunctionCache::indexForParameter(bool isCartesian, float t,
+                                               int curveIndex) const {
   assert(!std::isnan(t));
   if (curveIndex != 0 || std::isinf(t)) {
     /* TODO: For now, second curves are not cached. It may (or not) be slightly
@@ -122,11 +262,11 @@ int ContinuousFunctionCache::indexForParameter(
   int res = std::round(delta);
   assert(res >= 0);
   if ((res >= k_sizeOfCache) ||
-      (res >= k_sizeOfCache / 2 && !function->properties().isCartesian()) ||
+      (res >= k_sizeOfCache / 2 && !isCartesian) ||
       std::fabs(res - delta) > k_cacheHitTolerance) {
     return -1;
   }
-  assert(function->properties().isCartesian() || m_startOfCache == 0);
+  assert(isCartesian || m_startOfCache == 0);
   return (res + m_startOfCache) % k_sizeOfCache;
 }
 
@@ -134,23 +274,43 @@ Poincare::Coordinate2D<float> ContinuousFunctionCache::valuesAtIndex(
     const ContinuousFunction *function, Poincare::Context *context, float t,
     int i, int curveIndex) {
   assert(curveIndex == 0);
-  if (function->properties().isCartesian()) {
-    if (OMG::IsSignalingNan(m_cache[i])) {
-      m_cache[i] =
-          function->privateEvaluateXYAtParameter(t, context, curveIndex).y();
-    }
-    return Poincare::Coordinate2D<float>(t, m_cache[i]);
+  bool isCartesian = function->properties().isCartesian();
+  if (!hasValuesAtIndex(isCartesian, i)) {
+    setValuesAtIndex(
+        isCartesian, i,
+        function->privateEvaluateXYAtParameter(t, context, curveIndex));
+  }
+  return cachedValuesAtIndex(isCartesian, t, i);
+}
+
+bool ContinuousFunctionCache::hasValuesAtIndex(bool isCartesian,
+                                               int i) const {
+  if (isCartesian) {
+    return !OMG::IsSignalingNan(m_cache[i]);
   }
-  if (OMG::IsSignalingNan(m_cache[2 * i]) ||
-      OMG::IsSignalingNan(m_cache[2 * i + 1])) {
-    Poincare::Coordinate2D<float> res =
-        function->privateEvaluateXYAtParameter(t, context, curveIndex);
-    m_cache[2 * i] = res.x();
-    m_cache[2 * i + 1] = res.y();
+  return !OMG::IsSignalingNan(m_cache[2 * i]) &&
+         !OMG::IsSignalingNan(m_cache[2 * i + 1]);
+}
+
+Poincare::Coordinate2D<float> ContinuousFunctionCache::cachedValuesAtIndex(
+    bool isCartesian, float t, int i) const {
+  assert(hasValuesAtIndex(isCartesian, i));
+  if (isCartesian) {
+    return Poincare::Coordinate2D<float>(t, m_cache[i]);
   }
   return Poincare::Coordinate2D<float>(m_cache[2 * i], m_cache[2 * i + 1]);
 }
 
+void ContinuousFunctionCache::setValuesAtIndex(
+    bool isCartesian, int i, Poincare::Coordinate2D<float> xy) {
+  if (isCartesian) {
+    m_cache[i] = xy.y();
+    return;
+  }
+  m_cache[2 * i] = xy.x();
+  m_cache[2 * i + 1] = xy.y();
+}
+
 void ContinuousFunctionCache::pan(ContinuousFunction *function, float newTMin) {
   assert(function->properties().isCartesian());
   if (newTMin == m_tMin) {
@@ -3,6 +3,7 @@
 
 #include <float.h>
 #include <ion/display.h>
+#include <poincare/compiled_approximation.h>
 #include <poincare/context.h>
 #include <poincare/coordinate_2D.h>
 
@@ -12,6 +13,30 @@ class ContinuousFunction;
 
 class ContinuousFunctionCache {
  public:
+  /* What is needed to evaluate a curve with its compiled programs, read from
+   * the function record beforehand (see ContinuousFunction::compiledCurve).
+   * Evaluating it neither reads the storage nor uses the TreePool. */
+  struct CompiledCurve {
+    bool isCompiled() const {
+      return x2 && x2->isCompiled() && (!x1 || x1->isCompiled());
+    }
+    void evaluateXYAtParameters(const float* t,
+                                Poincare::Coordinate2D<float>* xy,
+                                int numberOfParameters) const;
+
+    // x1 is only compiled for parametric curves, x2 is the main program
+    const Poincare::CompiledApproximation* x1;
+    const Poincare::CompiledApproximation* x2;
+    float tMin;
+    float tMax;
+    // Polar angles are converted to radians with M_PI / piInAngleUnit
+    double piInAngleUnit;
+    bool isCartesian;
+    bool isAlongY;
+    bool isPolar;
+    bool isInversePolar;
+  };
+
   static void PrepareForCaching(void* fun, ContinuousFunctionCache* cache,
                                 float tMin, float tStep);
 
@@ -22,6 +47,21 @@ class ContinuousFunctionCache {
   Poincare::Coordinate2D<float> valueForParameter(
       const ContinuousFunction* function, Poincare::Context* context, float t,
       int curveIndex);
+  void valuesForParameters(const ContinuousFunction* function,
+                           Poincare::Context* context, const float* t,
+                           Poincare::Coordinate2D<float>* xy,
+                           int numberOfParameters, int curveIndex);
+  /* Fill the cache from its tMin up to tMax with a compiled curve. It only
+   * reads curve and writes the cache, so that several caches can be filled
+   * on different threads. */
+  void fillUpTo(const CompiledCurve& curve, float tMax);
+#if GRAPH_HOST_THREADS
+  /* Fill caches[i] with curves[i] up to tMax[i], one thread per cache, the
+   * first one running on the calling thread. */
+  static void FillConcurrently(ContinuousFunctionCache* const* caches,
+                               const CompiledCurve* curves, const float* tMax,
+                               int numberOfCaches);
+#endif
   // Sets step parameters for non-cartesian curves
   static void ComputeNonCartesianSteps(float* tStep, float* tCacheStep,
                                        float tMax, float tMin);
@@ -54,11 +94,15 @@ class ContinuousFunctionCache {
 
   void invalidateBetween(int iInf, int iSup);
   void setRange(float tMin, float tStep);
-  int indexForParameter(const ContinuousFunction* function, float t,
-                        int curveIndex) const;
+  int indexForParameter(bool isCartesian, float t, int curveIndex) const;
   Poincare::Coordinate2D<float> valuesAtIndex(
       const ContinuousFunction* function, Poincare::Context* context, float t,
       int i, int curveIndex);
+  bool hasValuesAtIndex(bool isCartesian, int i) const;
+  Poincare::Coordinate2D<float> cachedValuesAtIndex(bool isCartesian, float t,
+                                                    int i) const;
+  void setValuesAtIndex(bool isCartesian, int i,
+                        Poincare::Coordinate2D<float> xy);
   void pan(ContinuousFunction* function, float newTMin);
 
   float m_tMin, m_tStep;
@@ -44,15 +44,25 @@ KDColor Function::color(int derivationOrder) const {
 
 void Function::setColor(KDColor color, int derivationOrder) {
   recordData()->setColor(color, derivationOrder);
+  DidChangeRecordData();
 }
 
 void Function::setActive(bool active) {
   recordData()->setActive(active);
+  DidChangeRecordData();
   if (!active) {
     didBecomeInactive();
   }
 }
 
+void Function::evaluateXYAtParameters(const float *t, Coordinate2D<float> *xy,
+                                      int numberOfParameters, Context *context,
+                                      int subCurveIndex) const {
+  for (int i = 0; i < numberOfParameters; i++) {
+    xy[i] = evaluateXYAtParameter(t[i], context, subCurveIndex);
+  }
+}
+
 size_t Function::printAbscissaValue(double cursorT, double cursorX,
                                     char *buffer, size_t bufferSize,
                                     int precision) {
@@ -71,6 +71,13 @@ class Function : public ExpressionModelHandle {
       float t, Poincare::Context* context, int subCurveIndex = 0) const = 0;
   virtual Poincare::Coordinate2D<double> evaluateXYAtParameter(
       double t, Poincare::Context* context, int subCurveIndex = 0) const = 0;
+  /* Evaluate several parameters at once. Subclasses can share work between the
+   * evaluations, the default implementation evaluates them one by one. */
+  virtual void evaluateXYAtParameters(const float* t,
+                                      Poincare::Coordinate2D<float>* xy,
+                                      int numberOfParameters,
+                                      Poincare::Context* context,
+                                      int subCurveIndex = 0) const;
   virtual Poincare::Expression sumBetweenBounds(
       double start, double end, Poincare::Context* context) const = 0;
 
@@ -121,6 +128,11 @@ class Function : public ExpressionModelHandle {
   };
 
   virtual void didBecomeInactive() {}
+  /* Metadata setters write the record data in place: the version of the
+   * storage is bumped so that memoized reductions are not reused. */
+  static void DidChangeRecordData() {
+    Ion::Storage::FileSystem::sharedFileSystem->didChangeRecordInPlace();
+  }
 
  private:
   RecordDataBuffer* recordData() const;
@@ -59,6 +59,10 @@ class GlobalContext final : public Poincare::Context {
   SequenceContext *sequenceContext() { return &m_sequenceContext; }
   void tidyDownstreamPoolFrom(
       Poincare::TreeNode *treePoolCursor = nullptr) override;
+  // Symbols are only defined by the records of the storage
+  uint32_t versionForReductionCache() override {
+    return Ion::Storage::FileSystem::sharedFileSystem->version();
+  }
   void prepareForNewApp();
   void reset();
 
@@ -153,29 +153,40 @@ void WithCurves::CurveDrawing::draw(const AbstractPlotView *plotView,
 
   plotView->setDashed(m_dashed);
 
-  float previousT = NAN, t = NAN;
-  Coordinate2D<float> previousXY, xy;
+  float previousT = NAN;
+  Coordinate2D<float> previousXY;
+  float t[k_batchSize];
+  Coordinate2D<float> xy[k_batchSize];
   int i = 0;
   bool isLastSegment = false;
 
   do {
-    previousT = t;
-    t = m_tStart + (i++) * m_tStep;
-    if (t <= m_tStart) {
-      t = m_tStart + FLT_EPSILON;
-    }
-    if (t >= m_tEnd) {
-      t = m_tEnd - FLT_EPSILON;
-      isLastSegment = true;
+    // Gather the next parameters to evaluate them at once
+    int numberOfParameters = 0;
+    float lastT = previousT;
+    while (numberOfParameters < k_batchSize && !isLastSegment) {
+      float nextT = m_tStart + (i++) * m_tStep;
+      if (nextT <= m_tStart) {
+        nextT = m_tStart + FLT_EPSILON;
+      }
+      if (nextT >= m_tEnd) {
+        nextT = m_tEnd - FLT_EPSILON;
+        isLastSegment = true;
+      }
+      if (lastT == nextT) {
+        // No need to draw segment. Happens when tStep << tStart .
+        continue;
+      }
+      t[numberOfParameters++] = nextT;
+      lastT = nextT;
     }
-    if (previousT == t) {
-      // No need to draw segment. Happens when tStep << tStart .
-      continue;
+    m_curve.evaluate(t, xy, numberOfParameters, m_context);
+    for (int j = 0; j < numberOfParameters; j++) {
+      joinDots(plotView, ctx, rect, previousT, previousXY, t[j], xy[j],
+               k_maxNumberOfIterations, m_discontinuity);
+      previousT = t[j];
+      previousXY = xy[j];
     }
-    previousXY = xy;
-    xy = m_curve.evaluate(t, m_context);
-    joinDots(plotView, ctx, rect, previousT, previousXY, t, xy,
-             k_maxNumberOfIterations, m_discontinuity);
   } while (!isLastSegment);
 
   plotView->setDashed(false);
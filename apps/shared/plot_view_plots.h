@@ -24,19 +24,39 @@ class WithCurves {
   using Curve2DEvaluation = Poincare::Coordinate2D<T> (*)(T, void *model,
                                                           void *context);
 
+  /* Optional evaluation of several parameters at once, for models able to
+   * share work between evaluations. */
+  using Curve2DEvaluationBatch = void (*)(const float *t,
+                                          Poincare::Coordinate2D<float> *xy,
+                                          int numberOfParameters, void *model,
+                                          void *context);
+
   class Curve2D {
    public:
-    Curve2D(Curve2DEvaluation<float> f = nullptr, void *model = nullptr)
-        : m_f(f), m_model(model) {}
+    Curve2D(Curve2DEvaluation<float> f = nullptr, void *model = nullptr,
+            Curve2DEvaluationBatch fBatch = nullptr)
+        : m_f(f), m_fBatch(fBatch), m_model(model) {}
     operator bool() const { return m_f != nullptr; }
     void *model() const { return m_model; }
     Poincare::Coordinate2D<float> evaluate(float t, void *context) const {
       assert(m_f);
       return m_f(t, m_model, context);
     }
+    void evaluate(const float *t, Poincare::Coordinate2D<float> *xy,
+                  int numberOfParameters, void *context) const {
+      assert(m_f);
+      if (m_fBatch) {
+        m_fBatch(t, xy, numberOfParameters, m_model, context);
+        return;
+      }
+      for (int i = 0; i < numberOfParameters; i++) {
+        xy[i] = m_f(t[i], m_model, context);
+      }
+    }
 
    private:
     Curve2DEvaluation<float> m_f;
+    Curve2DEvaluationBatch m_fBatch;
     void *m_model;
   };
 
@@ -103,6 +123,8 @@ class WithCurves {
      * screen though.
      */
     constexpr static int k_maxNumberOfIterations = 8;
+    // Number of parameters evaluated at once along the curve
+    constexpr static int k_batchSize = 16;
 
     void joinDots(const AbstractPlotView *plotView, KDContext *ctx, KDRect rect,
                   float t1, Poincare::Coordinate2D<float> xy1, float t2,
@@ -52,6 +52,7 @@ void Sequence::setType(Type t) {
     return;
   }
   recordData()->setType(t);
+  DidChangeRecordData();
   m_definition.tidyName();
   tidyDownstreamPoolFrom();
   /* Reset all contents */
@@ -96,6 +97,7 @@ void Sequence::setType(Type t) {
 
 void Sequence::setInitialRank(int rank) {
   recordData()->setInitialRank(rank);
+  DidChangeRecordData();
   m_firstInitialCondition.tidyName();
   m_secondInitialCondition.tidyName();
 }
@@ -42,7 +42,10 @@ class Sequence : public Function {
   // MetaData setters
   void setType(Type type);
   void setInitialRank(int rank);
-  void setDisplaySum(bool display) { recordData()->setDisplaySum(display); }
+  void setDisplaySum(bool display) {
+    recordData()->setDisplaySum(display);
+    DidChangeRecordData();
+  }
 
   // Definition
   Poincare::Layout definitionName() { return m_definition.name(this); }
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+
+# Compare two reports written by the simulator with --benchmark, for instance:
+#   epsilon.bin --headless --virtual-clock --batch manifest.txt \
+#     --benchmark base.jsonl
+# benchmark_diff.py base.jsonl head.jsonl --min-ratio 1.2
+
+COUNTERS = [
+    "redraws",
+    "pushed_rects",
+    "pushed_pixels",
+    "pool_peak_bytes",
+    "python_heap_bytes",
+]
+DURATIONS = ["dispatch_us", "redraw_us"]
+
+
+def load_report(path):
+    events = {}
+    totals = {}
+    with open(path) as report:
+        for line in report:
+            measure = json.loads(line)
+            scenario = measure["scenario"]
+            if "events" in measure:
+                totals[scenario] = measure
+            else:
+                events[(scenario, measure["index"])] = measure
+    return events, totals
+
+
+def format_change(base, head):
+    if base == 0:
+        return "{} -> {}".format(base, head)
+    return "{} -> {} ({:+.0%})".format(base, head, head / base - 1)
+
+
+def regressions(base, head, min_ratio, min_duration):
+    changes = []
+    for counter in COUNTERS:
+        if base[counter] != head[counter]:
+            changes.append(
+                "{}: {}".format(
+                    counter, format_change(base[counter], head[counter])
+                )
+            )
+    for duration in DURATIONS:
+        if (
+            head[duration] >= min_duration
+            and head[duration] > min_ratio * base[duration]
+        ):
+            changes.append(
+                "{}: {}".format(
+                    duration, format_change(base[duration], head[duration])
+                )
+            )
+    return changes
+
+
+parser = argparse.ArgumentParser(
+    description="Compare the per-event costs of two benchmark reports. Counters are reported whenever they differ, durations when they grew by more than a ratio."
+)
+parser.add_argument("base", help="report of the reference build")
+parser.add_argument("head", help="report of the build to check")
+parser.add_argument(
+    "--min-ratio",
+    type=float,
+    default=1.5,
+    help="report durations that grew by more than this ratio (default: 1.5)",
+)
+parser.add_argument(
+    "--min-duration",
+    type=int,
+    default=1000,
+    help="ignore durations shorter than this, in microseconds (default: 1000)",
+)
+
+
+def main():
+    args = parser.parse_args()
+    base_events, base_totals = load_report(args.base)
+    head_events, head_totals = load_report(args.head)
+    number_of_changes = 0
+    for scenario, head_total in head_totals.items():
+        base_total = base_totals.get(scenario)
+        if base_total is None:
+            print("{}: only in head".format(scenario))
+            continue
+        if base_total["events"] != head_total["events"]:
+            print(
+                "{}: {} events in base, {} in head".format(
+                    scenario, base_total["events"], head_total["events"]
+                )
+            )
+            number_of_changes += 1
+            continue
+        lines = []
+        for index in range(head_total["events"]):
+            base = base_events[(scenario, index)]
+            head = head_events[(scenario, index)]
+            changes = regressions(base, head, args.min_ratio, args.min_duration)
+            if changes:
+                lines.append(
+                    "  event #{} ({}): {}".format(
+                        index, head["event"], ", ".join(changes)
+                    )
+                )
+        if lines:
+            total_changes = regressions(base_total, head_total, args.min_ratio, 0)
+            print("{}: {}".format(scenario, ", ".join(total_changes)))
+            print("\n".join(lines))
+            number_of_changes += 1
+    print("{} scenarios changed".format(number_of_changes))
+
+
+if __name__ == "__main__":
+    main()
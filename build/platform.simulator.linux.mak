@@ -2,4 +2,8 @@ TOOLCHAIN = host-gcc
 EXE = bin
 
 EPSILON_TELEMETRY ?= 0
+POINCARE_THREAD_LOCAL_POOL ?= 1
+ifeq ($(shell uname -m),x86_64)
+PYTHON_NATIVE_EMITTER ?= 1
+endif
 TERMS_OF_USE ?= 0
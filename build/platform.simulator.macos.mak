@@ -4,6 +4,7 @@ EXE = bin
 APPLE_PLATFORM = macos
 APPLE_PLATFORM_MIN_VERSION = 10.10
 EPSILON_TELEMETRY ?= 0
+POINCARE_THREAD_LOCAL_POOL ?= 1
 TERMS_OF_USE ?= 0
 
 ifeq ($(DEBUG),1)
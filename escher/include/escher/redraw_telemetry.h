@@ -0,0 +1,91 @@
+#ifndef ESCHER_REDRAW_TELEMETRY_H
+#define ESCHER_REDRAW_TELEMETRY_H
+
+#include <ion/events.h>
+#include <kandinsky/rect.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#if ESCHER_REDRAW_TELEMETRY
+
+namespace Escher {
+
+class View;
+
+/* RedrawTelemetry tells which views are redrawn between two events, and who
+ * made them dirty. While it records, it reports after each event:
+ * - for each view class that drew, how many times it did, for how long, the
+ *   pixels it had to redraw and the pixels it actually pushed to the display,
+ * - for each view class and calling function that marked a rect as dirty, how
+ *   many times it did and the pixels it covered.
+ * Views are told apart by their vtable, which are named after their symbols
+ * when the host can look them up. Each event is reported as a JSON line:
+ *   {"scenario": "graph.nws", "index": 2, "event": 1, "views": [
+ *    {"class": "Escher::MessageTextView", "draws": 2, "draw_us": 12,
+ *     "visible_pixels": 2000, "pushed_pixels": 3400}], "dirty_sources": [
+ *    {"class": "Escher::TextCursorView", "caller": "...", "marks": 1,
+ *     "pixels": 36}]}
+ * pushed_pixels over visible_pixels is the overdraw of a class. The index
+ * counts the events from 0. What happens without an event, like the redraws
+ * of timers, is reported with the None event and the index of the last one. */
+
+class RedrawTelemetry {
+ public:
+  static RedrawTelemetry* SharedTelemetry() { return &s_sharedTelemetry; }
+
+  /* Report to a file, or to the console if the path is "-". The file is
+   * truncated on the first start of the process and appended to afterwards. */
+  bool start(const char* reportPath, const char* scenarioName);
+  void stop();
+  bool isRecording() const { return m_isRecording; }
+
+  void viewWillDraw();
+  void viewDidDraw(const View* view, KDRect rect);
+  void viewDidMarkRectAsDirty(const View* view, KDRect rect,
+                              const void* caller);
+  // Report and forget what was recorded since the previous call
+  void eventDidDispatch(Ion::Events::Event event);
+
+ private:
+  constexpr static int k_maxNumberOfClasses = 256;
+  constexpr static int k_maxNumberOfDirtySources = 256;
+
+  struct ClassStats {
+    const void* vtable;
+    int numberOfDraws;
+    int64_t drawDuration;  // In microseconds
+    int64_t numberOfVisiblePixels;
+    int64_t numberOfPushedPixels;
+  };
+  struct DirtySource {
+    const void* vtable;
+    const void* caller;
+    int numberOfMarks;
+    int64_t numberOfPixels;
+  };
+
+  static RedrawTelemetry s_sharedTelemetry;
+
+  void write(const char* text);
+  // Write text escaped for a JSON string, without the quotes
+  void writeEscaped(const char* text);
+  void writeSymbol(const void* address, bool isVtable);
+
+  FILE* m_report;
+  const char* m_scenarioName;
+  ClassStats m_classes[k_maxNumberOfClasses];
+  DirtySource m_dirtySources[k_maxNumberOfDirtySources];
+  int m_numberOfClasses;
+  int m_numberOfDirtySources;
+  int m_numberOfEvents;
+  int64_t m_drawStart;
+  int64_t m_numberOfPushedPixelsAtDrawStart;
+  bool m_isRecording;
+  bool m_reportWasCreated;
+};
+
+}  // namespace Escher
+
+#endif
+
+#endif
@@ -141,6 +141,8 @@ class TextArea : public TextInput {
    protected:
     KDRect glyphFrameAtPosition(const char* text,
                                 const char* position) const override;
+    // Called once the text was modified from position onwards
+    virtual void textDidChangeFromPosition(const char* position) {}
     Text m_text;
   };
 
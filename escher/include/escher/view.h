@@ -80,7 +80,12 @@ class View {
   void markRectAsDirty(KDRect rect);
   void markAbsoluteRectAsDirty(KDRect rect);
   // Doing this is equivalent to markAbsoluteRectAsDirty(m_frame) but faster
+#if ESCHER_REDRAW_TELEMETRY
+  // Out of line, so that the telemetry can tell who called it
+  void markWholeFrameAsDirty();
+#else
   void markWholeFrameAsDirty() { m_dirtyRect = m_frame; }
+#endif
 
 #if ESCHER_VIEW_LOGGING
   virtual const char *className() const;
@@ -94,6 +99,7 @@ class View {
   virtual void layoutSubviews(bool force = false) {}
   void translate(KDPoint origin);
   KDRect redraw(KDRect rect, KDRect forceRedrawRect = KDRectZero);
+  void unionDirtyRect(KDRect absoluteRect);
 
   /* At destruction, subviews aren't notified that their own pointer
    * 'm_superview' is outdated. This is not an issue since all view hierarchy
@@ -7,10 +7,25 @@ namespace Escher {
 
 class Window : public View {
  public:
-  Window() : m_contentView(nullptr) {}
+  Window()
+      : m_contentView(nullptr)
+#if ESCHER_REDRAW_TELEMETRY
+        ,
+        m_telemetry{0, 0}
+#endif
+  {
+  }
   void redraw(bool force = false);
   void setContentView(View* contentView);
   void setAbsoluteFrame(KDRect frame) { m_frame = frame; }
+#if ESCHER_REDRAW_TELEMETRY
+  struct Telemetry {
+    // Redraws since the window was built, and the time they took
+    int numberOfRedraws;
+    int64_t redrawDuration;  // In microseconds
+  };
+  const Telemetry& telemetry() const { return m_telemetry; }
+#endif
 
  protected:
 #if ESCHER_VIEW_LOGGING
@@ -20,6 +35,9 @@ class Window : public View {
   void layoutSubviews(bool force = false) override;
   View* subviewAtIndex(int index) override;
   View* m_contentView;
+#if ESCHER_REDRAW_TELEMETRY
+  Telemetry m_telemetry;
+#endif
 };
 
 }  // namespace Escher
@@ -1,3 +1,4 @@
+#include <escher/clipboard.h>
 #include <escher/init.h>
 #include <escher/text_cursor_view.h>
 #include <kandinsky/ion_context.h>
@@ -9,4 +10,10 @@ void Init() {
   TextCursorView::InitSharedCursor();
 }
 
+void Shutdown() {
+  TextCursorView::DeinitSharedCursor();
+  KDIonContext::SharedContext.deinit();
+  Clipboard::SharedClipboard()->reset();
+}
+
 }  // namespace Escher
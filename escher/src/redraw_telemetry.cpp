@@ -0,0 +1,242 @@
+#include <escher/redraw_telemetry.h>
+
+#if ESCHER_REDRAW_TELEMETRY
+
+#include <assert.h>
+#include <escher/view.h>
+#include <ion/console.h>
+#include <kandinsky/ion_context.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#if __has_include(<dlfcn.h>) && __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#define ESCHER_REDRAW_TELEMETRY_SYMBOLS 1
+#endif
+
+namespace Escher {
+
+RedrawTelemetry RedrawTelemetry::s_sharedTelemetry;
+
+static int64_t Microseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static int64_t NumberOfPushedPixels() {
+#if KANDINSKY_DISPLAY_TELEMETRY
+  return KDIonContext::SharedContext->telemetry().numberOfPushedPixels;
+#else
+  return 0;
+#endif
+}
+
+static const void* Vtable(const View* view) {
+  return *reinterpret_cast<const void* const*>(view);
+}
+
+// Calls from anywhere in a function are attributed to the function
+static const void* FunctionOf(const void* address) {
+#if ESCHER_REDRAW_TELEMETRY_SYMBOLS
+  Dl_info info;
+  if (dladdr(address, &info) && info.dli_saddr) {
+    return info.dli_saddr;
+  }
+#endif
+  return address;
+}
+
+static int64_t Area(KDRect rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+bool RedrawTelemetry::start(const char* reportPath, const char* scenarioName) {
+  assert(!m_isRecording);
+  if (strcmp(reportPath, "-") == 0) {
+    m_report = nullptr;
+  } else {
+    m_report = fopen(reportPath, m_reportWasCreated ? "a" : "w");
+    if (m_report == nullptr) {
+      return false;
+    }
+    m_reportWasCreated = true;
+  }
+  m_scenarioName = scenarioName;
+  m_numberOfClasses = 0;
+  m_numberOfDirtySources = 0;
+  m_numberOfEvents = 0;
+  m_isRecording = true;
+  return true;
+}
+
+void RedrawTelemetry::stop() {
+  if (m_report) {
+    fclose(m_report);
+    m_report = nullptr;
+  }
+  m_isRecording = false;
+}
+
+void RedrawTelemetry::viewWillDraw() {
+  m_numberOfPushedPixelsAtDrawStart = NumberOfPushedPixels();
+  m_drawStart = Microseconds();
+}
+
+void RedrawTelemetry::viewDidDraw(const View* view, KDRect rect) {
+  int64_t drawDuration = Microseconds() - m_drawStart;
+  const void* vtable = Vtable(view);
+  int i = 0;
+  while (i < m_numberOfClasses && m_classes[i].vtable != vtable) {
+    i++;
+  }
+  if (i == k_maxNumberOfClasses) {
+    return;
+  }
+  if (i == m_numberOfClasses) {
+    m_classes[i] = {vtable, 0, 0, 0, 0};
+    m_numberOfClasses++;
+  }
+  m_classes[i].numberOfDraws++;
+  m_classes[i].drawDuration += drawDuration;
+  m_classes[i].numberOfVisiblePixels += Area(rect);
+  m_classes[i].numberOfPushedPixels +=
+      NumberOfPushedPixels() - m_numberOfPushedPixelsAtDrawStart;
+}
+
+void RedrawTelemetry::viewDidMarkRectAsDirty(const View* view, KDRect rect,
+                                             const void* caller) {
+  const void* vtable = Vtable(view);
+  caller = FunctionOf(caller);
+  int i = 0;
+  while (i < m_numberOfDirtySources &&
+         (m_dirtySources[i].vtable != vtable ||
+          m_dirtySources[i].caller != caller)) {
+    i++;
+  }
+  if (i == k_maxNumberOfDirtySources) {
+    return;
+  }
+  if (i == m_numberOfDirtySources) {
+    m_dirtySources[i] = {vtable, caller, 0, 0};
+    m_numberOfDirtySources++;
+  }
+  m_dirtySources[i].numberOfMarks++;
+  m_dirtySources[i].numberOfPixels += Area(rect);
+}
+
+void RedrawTelemetry::eventDidDispatch(Ion::Events::Event event) {
+  if (event != Ion::Events::None) {
+    m_numberOfEvents++;
+  }
+  if (m_numberOfClasses == 0 && m_numberOfDirtySources == 0) {
+    return;
+  }
+  constexpr static int k_bufferSize = 160;
+  char buffer[k_bufferSize];
+  write("{\"scenario\": \"");
+  writeEscaped(m_scenarioName);
+  snprintf(buffer, k_bufferSize,
+           "\", \"index\": %d, \"event\": %d, \"views\": [",
+           m_numberOfEvents - 1, static_cast<uint8_t>(event));
+  write(buffer);
+  for (int i = 0; i < m_numberOfClasses; i++) {
+    const ClassStats& stats = m_classes[i];
+    write(i == 0 ? "{\"class\": \"" : ", {\"class\": \"");
+    writeSymbol(stats.vtable, true);
+    snprintf(buffer, k_bufferSize,
+             "\", \"draws\": %d, \"draw_us\": %lld, \"visible_pixels\": "
+             "%lld, \"pushed_pixels\": %lld}",
+             stats.numberOfDraws, static_cast<long long>(stats.drawDuration),
+             static_cast<long long>(stats.numberOfVisiblePixels),
+             static_cast<long long>(stats.numberOfPushedPixels));
+    write(buffer);
+  }
+  write("], \"dirty_sources\": [");
+  for (int i = 0; i < m_numberOfDirtySources; i++) {
+    const DirtySource& source = m_dirtySources[i];
+    write(i == 0 ? "{\"class\": \"" : ", {\"class\": \"");
+    writeSymbol(source.vtable, true);
+    write("\", \"caller\": \"");
+    writeSymbol(source.caller, false);
+    snprintf(buffer, k_bufferSize, "\", \"marks\": %d, \"pixels\": %lld}",
+             source.numberOfMarks,
+             static_cast<long long>(source.numberOfPixels));
+    write(buffer);
+  }
+  write("]}\n");
+  if (m_report) {
+    fflush(m_report);
+  }
+  m_numberOfClasses = 0;
+  m_numberOfDirtySources = 0;
+}
+
+void RedrawTelemetry::write(const char* text) {
+  if (m_report) {
+    fputs(text, m_report);
+  } else {
+    Ion::Console::writeLine(text, false);
+  }
+}
+
+void RedrawTelemetry::writeEscaped(const char* text) {
+  // Escaped like the scenario names of the benchmark reports
+  constexpr static int k_bufferSize = 64;
+  // The longest escape, \u00XX, and the null terminator
+  constexpr static int k_maxEscapedSize = 7;
+  char buffer[k_bufferSize];
+  int length = 0;
+  for (const char* c = text; *c != 0; c++) {
+    if (length + k_maxEscapedSize > k_bufferSize) {
+      buffer[length] = 0;
+      write(buffer);
+      length = 0;
+    }
+    if (*c == '"' || *c == '\\') {
+      buffer[length++] = '\\';
+      buffer[length++] = *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      length += snprintf(buffer + length, k_bufferSize - length, "\\u%04x",
+                         static_cast<unsigned char>(*c));
+    } else {
+      buffer[length++] = *c;
+    }
+  }
+  buffer[length] = 0;
+  write(buffer);
+}
+
+void RedrawTelemetry::writeSymbol(const void* address, bool isVtable) {
+#if ESCHER_REDRAW_TELEMETRY_SYMBOLS
+  Dl_info info;
+  if (dladdr(address, &info) && info.dli_sname) {
+    int status;
+    char* name =
+        abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    if (name) {
+      constexpr const char* k_vtablePrefix = "vtable for ";
+      size_t prefixLength = strlen(k_vtablePrefix);
+      writeEscaped(
+          isVtable && strncmp(name, k_vtablePrefix, prefixLength) == 0
+              ? name + prefixLength
+              : name);
+      free(name);
+      return;
+    }
+  }
+#endif
+  // The symbol is unknown, report the address
+  char buffer[2 + 2 * sizeof(uintptr_t) + 1];
+  snprintf(buffer, sizeof(buffer), "0x%llx",
+           static_cast<unsigned long long>(
+               reinterpret_cast<uintptr_t>(address)));
+  write(buffer);
+}
+
+}  // namespace Escher
+
+#endif
@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <escher/redraw_telemetry.h>
 #include <escher/run_loop.h>
 #include <kandinsky/font.h>
 #if ESCHER_LOG_EVENTS_NAME
@@ -90,6 +91,11 @@ bool RunLoop::step() {
 #endif
     dispatchEvent(event);
   }
+#if ESCHER_REDRAW_TELEMETRY
+  if (RedrawTelemetry::SharedTelemetry()->isRecording()) {
+    RedrawTelemetry::SharedTelemetry()->eventDidDispatch(event);
+  }
+#endif
 
   return event != Ion::Events::Termination;
 }
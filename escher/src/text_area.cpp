@@ -576,6 +576,7 @@ KDSize TextArea::ContentView::minimalSizeForOptimalDisplay() const {
 void TextArea::ContentView::setText(char *textBuffer, size_t textBufferSize) {
   m_text.setText(textBuffer, textBufferSize);
   m_cursorLocation = text();
+  textDidChangeFromPosition(text());
 }
 
 bool TextArea::ContentView::insertTextAtLocation(const char *text,
@@ -595,6 +596,7 @@ bool TextArea::ContentView::insertTextAtLocation(const char *text,
   // parentheses
   Poincare::SerializationHelper::
       ReplaceSystemParenthesesAndBracesByUserParentheses(location, textLen);
+  textDidChangeFromPosition(location);
   reloadRectFromPosition(location, lineBreak);
   return true;
 }
@@ -608,7 +610,8 @@ bool TextArea::ContentView::removePreviousGlyph() {
   char *cursorLoc = const_cast<char *>(cursorLocation());
   lineBreak = m_text.removePreviousGlyph(&cursorLoc) == '\n';
   setCursorLocation(cursorLoc);  // Update the cursor
-  layoutSubviews();              // Reposition the cursor
+  textDidChangeFromPosition(cursorLoc);
+  layoutSubviews();  // Reposition the cursor
   reloadRectFromPosition(cursorLocation(), lineBreak);
   return true;
 }
@@ -617,6 +620,7 @@ bool TextArea::ContentView::removeEndOfLine() {
   size_t removedLine =
       m_text.removeRemainingLine(cursorLocation(), OMG::Direction::Right());
   if (removedLine > 0) {
+    textDidChangeFromPosition(cursorLocation());
     layoutSubviews();
     reloadRectFromPosition(cursorLocation(), false);
     return true;
@@ -634,6 +638,7 @@ bool TextArea::ContentView::removeStartOfLine() {
   if (removedLine > 0) {
     assert(cursorLocation() >= text() + removedLine);
     setCursorLocation(cursorLocation() - removedLine);
+    textDidChangeFromPosition(cursorLocation());
     reloadRectFromPosition(cursorLocation(), true);
     return true;
   }
@@ -641,7 +646,9 @@ bool TextArea::ContentView::removeStartOfLine() {
 }
 
 size_t TextArea::ContentView::removeText(const char *start, const char *end) {
-  return m_text.removeText(start, end);
+  size_t removedLength = m_text.removeText(start, end);
+  textDidChangeFromPosition(start);
+  return removedLength;
 }
 
 size_t TextArea::ContentView::deleteSelection() {
@@ -1,3 +1,4 @@
+#include <escher/redraw_telemetry.h>
 #include <escher/view.h>
 #include <kandinsky/ion_context.h>
 
@@ -7,16 +8,46 @@ extern "C" {
 
 namespace Escher {
 
-void View::markRectAsDirty(KDRect rect) {
+#if ESCHER_REDRAW_TELEMETRY
+/* The telemetry attributes each dirty rect to the function that marked it,
+ * which is the return address of these functions as long as they are not
+ * inlined. */
+#define ESCHER_MARK_DIRTY_ATTRIBUTES __attribute__((noinline))
+#define ESCHER_DID_MARK_RECT_AS_DIRTY(rect)                      \
+  if (RedrawTelemetry::SharedTelemetry()->isRecording()) {       \
+    RedrawTelemetry::SharedTelemetry()->viewDidMarkRectAsDirty(  \
+        this, (rect).intersectedWith(m_frame),                   \
+        __builtin_return_address(0));                            \
+  }
+#else
+#define ESCHER_MARK_DIRTY_ATTRIBUTES
+#define ESCHER_DID_MARK_RECT_AS_DIRTY(rect)
+#endif
+
+ESCHER_MARK_DIRTY_ATTRIBUTES void View::markRectAsDirty(KDRect rect) {
   assert(!SumOverflowsKDCoordinate(rect.origin().x(), m_frame.origin().x()));
   assert(!SumOverflowsKDCoordinate(rect.origin().y(), m_frame.origin().y()));
-  markAbsoluteRectAsDirty(rect.translatedBy(m_frame.origin()));
+  KDRect absoluteRect = rect.translatedBy(m_frame.origin());
+  ESCHER_DID_MARK_RECT_AS_DIRTY(absoluteRect);
+  unionDirtyRect(absoluteRect);
+}
+
+ESCHER_MARK_DIRTY_ATTRIBUTES void View::markAbsoluteRectAsDirty(KDRect rect) {
+  ESCHER_DID_MARK_RECT_AS_DIRTY(rect);
+  unionDirtyRect(rect);
 }
 
-void View::markAbsoluteRectAsDirty(KDRect rect) {
+#if ESCHER_REDRAW_TELEMETRY
+ESCHER_MARK_DIRTY_ATTRIBUTES void View::markWholeFrameAsDirty() {
+  ESCHER_DID_MARK_RECT_AS_DIRTY(m_frame);
+  m_dirtyRect = m_frame;
+}
+#endif
+
+void View::unionDirtyRect(KDRect absoluteRect) {
   /* Intersect with m_frame before unioning to avoid KDCoordinate overflow. */
   m_dirtyRect = m_dirtyRect.intersectedWith(m_frame).unionedWith(
-      rect.intersectedWith(m_frame));
+      absoluteRect.intersectedWith(m_frame));
 }
 
 KDRect View::redraw(KDRect rect, KDRect forceRedrawRect) {
@@ -48,7 +79,18 @@ KDRect View::redraw(KDRect rect, KDRect forceRedrawRect) {
     KDContext *ctx = KDIonContext::SharedContext;
     ctx->setOrigin(absOrigin);
     ctx->setClippingRect(rectNeedingRedraw);
+#if ESCHER_REDRAW_TELEMETRY
+    RedrawTelemetry* telemetry = RedrawTelemetry::SharedTelemetry();
+    if (telemetry->isRecording()) {
+      telemetry->viewWillDraw();
+      drawRect(ctx, rectNeedingRedraw.relativeTo(m_frame.origin()));
+      telemetry->viewDidDraw(this, rectNeedingRedraw);
+    } else {
+      drawRect(ctx, rectNeedingRedraw.relativeTo(m_frame.origin()));
+    }
+#else
     drawRect(ctx, rectNeedingRedraw.relativeTo(m_frame.origin()));
+#endif
   }
   // This initializes the area that has been redrawn.
   KDRect redrawnArea = rectNeedingRedraw;
@@ -1,5 +1,8 @@
 #include <escher/window.h>
 #include <ion.h>
+#if ESCHER_REDRAW_TELEMETRY
+#include <chrono>
+#endif
 extern "C" {
 #include <assert.h>
 }
@@ -11,7 +14,17 @@ void Window::redraw(bool force) {
     markWholeFrameAsDirty();
   }
   Ion::Display::waitForVBlank();
+#if ESCHER_REDRAW_TELEMETRY
+  auto start = std::chrono::steady_clock::now();
+#endif
   View::redraw(bounds());
+#if ESCHER_REDRAW_TELEMETRY
+  m_telemetry.numberOfRedraws++;
+  m_telemetry.redrawDuration +=
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+#endif
 }
 
 void Window::setContentView(View* contentView) {
@@ -0,0 +1,21 @@
+#ifndef ION_EXECUTABLE_MEMORY_H
+#define ION_EXECUTABLE_MEMORY_H
+
+#include <stddef.h>
+
+namespace Ion {
+namespace ExecutableMemory {
+
+/* Memory where generated machine code can be written and run. It is only
+ * provided by the simulator on hosts whose instruction set has a native code
+ * emitter. Blocks are never freed one by one: the whole memory is reclaimed at
+ * once by reset, when no generated code can be run anymore. */
+
+// Returns nullptr if there is not enough memory left
+void* allocate(size_t size);
+void reset();
+
+}  // namespace ExecutableMemory
+}  // namespace Ion
+
+#endif
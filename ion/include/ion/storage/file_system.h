@@ -6,6 +6,9 @@
 #include <omg/global_box.h>
 
 #include "record.h"
+#if ION_STORAGE_INDEX
+#include "record_index.h"
+#endif
 #include "record_name_verifier.h"
 #include "storage_delegate.h"
 #include "storage_helper.h"
@@ -42,6 +45,23 @@ class FileSystem {
   size_t putAvailableSpaceAtEndOfRecord(Record r);
   void getAvailableSpaceFromEndOfRecord(Record r, size_t recordAvailableSpace);
   uint32_t checksum();
+#if ION_SIMULATOR_FILES
+  /* An image of the storage holds its buffer framed by the magic numbers, as
+   * they are laid out in memory. */
+  constexpr static size_t k_imageSize =
+      sizeof(uint32_t) + k_storageSize + sizeof(uint32_t);
+  const void *image() const { return &m_magicHeader; }
+  /* Replace the records with those of an image, which is rejected if its
+   * magic numbers or record sizes are invalid. The system records of the image
+   * are kept where they are, since their values are accessed in place. */
+  bool loadImage(const void *image);
+#endif
+  /* Incremented at each change of the records, as a cheaper alternative to the
+   * checksum for memoizations that need to detect them. */
+  uint32_t version() const { return m_version; }
+  /* Records written in place through their pointer, without setValue, are
+   * not noticed by the storage: their writers must bump the version. */
+  void didChangeRecordInPlace() const { m_version++; }
 
   // Storage delegate
   void setDelegate(StorageDelegate *delegate) { m_delegate = delegate; }
@@ -85,6 +105,14 @@ class FileSystem {
 
   template <typename T>
   void initSystemRecord() {
+#if ION_SIMULATOR_FILES
+    // Keep the system record of a loaded image
+    Record record(T::k_recordName, Ion::Storage::systemExtension);
+    if (hasRecord(record) && record.value().size == sizeof(T)) {
+      return;
+    }
+    record.destroy();
+#endif
     assert(!hasRecord(
         Ion::Storage::Record(T::k_recordName, Ion::Storage::systemExtension)));
     T object;
@@ -212,6 +240,11 @@ class FileSystem {
   };
   RecordIterator end() const { return RecordIterator(nullptr); }
 
+#if ION_STORAGE_INDEX
+  void indexRecordStarting(char *start);
+  void rebuildIndex();
+#endif
+
   Record privateRecordBasedNamedWithExtensions(
       const char *baseName, int baseNameLength, const char *const extensions[],
       size_t numberOfExtensions, const char **extensionResult = nullptr);
@@ -227,6 +260,12 @@ class FileSystem {
   RecordNameVerifier m_recordNameVerifier;
   mutable Record m_lastRecordRetrieved;
   mutable char *m_lastRecordRetrievedPointer;
+  mutable uint32_t m_version;
+#if ION_STORAGE_INDEX
+  /* The index lies after m_magicFooter so that the layout of the storage seen
+   * from outside the userland does not depend on it. */
+  mutable RecordIndex m_index;
+#endif
 };
 
 }  // namespace Storage
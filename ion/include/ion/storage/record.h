@@ -88,6 +88,7 @@ class Record {
   static Record::ErrorStatus SetFullName(Record* record, const char* fullName);
 
  private:
+  friend class RecordIndex;
   uint32_t m_fullNameCRC32;
 };
 
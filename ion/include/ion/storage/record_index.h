@@ -0,0 +1,96 @@
+#ifndef ION_STORAGE_RECORD_INDEX_H
+#define ION_STORAGE_RECORD_INDEX_H
+
+#include <stdint.h>
+
+#include "record.h"
+
+namespace Ion {
+
+namespace Storage {
+
+/* RecordIndex keeps the offsets of the records in the FileSystem buffer, in
+ * storage order, along with their identifiers (the CRC32 of their names) and
+ * the ids of their extensions. The FileSystem updates it each time records
+ * are created, destroyed, renamed or moved, so that looking up a record by
+ * name or by extension does not scan the whole storage.
+ *
+ * A hash table from name CRC32 to record and the lists of the records of each
+ * extension are derived from these columns. They are rebuilt at the first
+ * lookup following a change.
+ *
+ * If the storage holds too many records or extensions, the index becomes
+ * invalid and the FileSystem falls back to scanning the buffer. */
+
+class RecordIndex {
+ public:
+  constexpr static int k_maxNumberOfRecords = 2048;
+  constexpr static int k_maxNumberOfExtensions = 32;
+  constexpr static int k_maxExtensionLength = 7;
+  constexpr static int k_noOffset = -1;
+
+  RecordIndex()
+      : m_numberOfRecords(0),
+        m_numberOfExtensions(0),
+        m_isValid(true),
+        m_isDirty(true) {}
+
+  bool isValid() const { return m_isValid; }
+  void invalidate() { m_isValid = false; }
+  void reset();
+
+  /* Updates. The extension of a record whose name is not compliant is
+   * nullptr, such records can only be found through lastOffset. */
+  void insert(uint16_t offset, Record record, const char* extension);
+  /* Remove the first record starting at offset, which can be shared with the
+   * next record if the buffer has already been slid over the removed one. */
+  void remove(uint16_t offset);
+  void rename(uint16_t offset, Record record, const char* extension);
+  // Add delta to the offsets of the records starting at or after offset
+  void shift(uint16_t offset, int delta);
+
+  // Lookups
+  int numberOfRecords() const { return m_numberOfRecords; }
+  int lastOffset() const {
+    return m_numberOfRecords > 0 ? m_offsets[m_numberOfRecords - 1]
+                                 : k_noOffset;
+  }
+  int offsetOfRecord(Record record);
+  int numberOfRecordsWithExtension(const char* extension);
+  int offsetOfRecordWithExtensionAtIndex(const char* extension, int index);
+
+ private:
+  constexpr static int k_hashTableSize = 2 * k_maxNumberOfRecords;
+  constexpr static uint8_t k_noExtension = 0xFF;
+  static_assert((k_hashTableSize & (k_hashTableSize - 1)) == 0,
+                "The size of the hash table must be a power of 2");
+
+  static uint32_t Hash(Record record) { return record.m_fullNameCRC32; }
+  int positionOfOffset(uint16_t offset) const;
+  uint8_t idOfExtension(const char* extension, bool intern);
+  void updateLookupTables();
+
+  // Columns, in storage order
+  uint16_t m_offsets[k_maxNumberOfRecords];
+  Record m_records[k_maxNumberOfRecords];
+  uint8_t m_extensionIds[k_maxNumberOfRecords];
+  char m_extensions[k_maxNumberOfExtensions][k_maxExtensionLength + 1];
+  int m_numberOfRecords;
+  int m_numberOfExtensions;
+
+  // Lookup tables, derived from the columns
+  // Positions in the columns, offset by one so that 0 marks an empty slot
+  uint16_t m_hashTable[k_hashTableSize];
+  // Positions in the columns, grouped by extension, in storage order
+  uint16_t m_positionsByExtension[k_maxNumberOfRecords];
+  uint16_t m_firstPositionOfExtension[k_maxNumberOfExtensions + 1];
+
+  bool m_isValid;
+  bool m_isDirty;
+};
+
+}  // namespace Storage
+
+}  // namespace Ion
+
+#endif
@@ -4,6 +4,10 @@
 namespace Ion {
 
 void Init();
+#if ION_SIMULATOR_FILES
+// Undo Init, so that the simulator can run ion_main again
+void Shutdown();
+#endif
 
 }
 
@@ -40,6 +40,9 @@ size_t FileSystem::putAvailableSpaceAtEndOfRecord(Record r) {
   char *nextRecord = p + previousRecordSize;
   memmove(nextRecord + availableStorageSize, nextRecord,
           (m_buffer + k_storageSize - availableStorageSize) - nextRecord);
+#if ION_STORAGE_INDEX
+  m_index.shift(nextRecord - m_buffer, availableStorageSize);
+#endif
   size_t newRecordSize = previousRecordSize + availableStorageSize;
   overrideSizeAtPosition(p, (record_size_t)newRecordSize);
   return newRecordSize;
@@ -52,6 +55,9 @@ void FileSystem::getAvailableSpaceFromEndOfRecord(Record r,
   char *nextRecord = p + previousRecordSize;
   memmove(nextRecord - recordAvailableSpace, nextRecord,
           m_buffer + k_storageSize - nextRecord);
+#if ION_STORAGE_INDEX
+  m_index.shift(nextRecord - m_buffer, -recordAvailableSpace);
+#endif
   overrideSizeAtPosition(
       p, (record_size_t)(previousRecordSize - recordAvailableSpace));
 }
@@ -60,9 +66,42 @@ uint32_t FileSystem::checksum() {
   return Ion::crc32Byte((const uint8_t *)m_buffer, endBuffer() - m_buffer);
 }
 
+#if ION_SIMULATOR_FILES
+bool FileSystem::loadImage(const void *image) {
+  static_assert(k_storageSize % sizeof(uint32_t) == 0,
+                "The magic footer must follow the buffer");
+  const char *header = static_cast<const char *>(image);
+  char *buffer = const_cast<char *>(header) + sizeof(m_magicHeader);
+  const char *footer = buffer + k_storageSize;
+  uint32_t magicHeader, magicFooter;
+  memcpy(&magicHeader, header, sizeof(magicHeader));
+  memcpy(&magicFooter, footer, sizeof(magicFooter));
+  if (magicHeader != Magic || magicFooter != Magic) {
+    return false;
+  }
+  // The records must end before the buffer does
+  size_t offset = 0;
+  record_size_t size;
+  while ((size = sizeOfRecordStarting(buffer + offset)) != 0) {
+    if (size < sizeof(record_size_t) ||
+        size > k_storageSize - sizeof(record_size_t) - offset) {
+      return false;
+    }
+    offset += size;
+  }
+  memcpy(m_buffer, buffer, k_storageSize);
+#if ION_STORAGE_INDEX
+  rebuildIndex();
+#endif
+  notifyChangeToDelegate();
+  return true;
+}
+#endif
+
 void FileSystem::notifyChangeToDelegate(const Record record) const {
   m_lastRecordRetrieved = Record(nullptr);
   m_lastRecordRetrievedPointer = nullptr;
+  m_version++;
   if (m_delegate) {
     m_delegate->storageDidChangeForRecord(record);
   }
@@ -185,6 +224,9 @@ Record::ErrorStatus FileSystem::createRecordWithDataChunks(
   }
   // Next Record is null-sized
   overrideSizeAtPosition(newRecord, 0);
+#if ION_STORAGE_INDEX
+  indexRecordStarting(newRecordAddress);
+#endif
   Record r = Record(recordName);
   m_lastRecordRetrieved = r;
   m_lastRecordRetrievedPointer = newRecordAddress;
@@ -195,6 +237,21 @@ Record::ErrorStatus FileSystem::createRecordWithDataChunks(
 int FileSystem::numberOfRecordsWithFilter(const char *extension,
                                           RecordFilter filter,
                                           const void *auxiliary) {
+#if ION_STORAGE_INDEX
+  if (m_index.isValid()) {
+    int numberOfRecords = m_index.numberOfRecordsWithExtension(extension);
+    if (filter == ExtensionOnlyFilter) {
+      return numberOfRecords;
+    }
+    int count = 0;
+    for (int i = 0; i < numberOfRecords; i++) {
+      char *p =
+          m_buffer + m_index.offsetOfRecordWithExtensionAtIndex(extension, i);
+      count += filter(nameOfRecordStarting(p), auxiliary);
+    }
+    return count;
+  }
+#endif
   int count = 0;
   for (char *p : *this) {
     Record::Name currentName = nameOfRecordStarting(p);
@@ -213,6 +270,27 @@ Record FileSystem::recordWithFilterAtIndex(const char *extension, int index,
   int currentIndex = -1;
   Record::Name name = Record::EmptyName();
   char *recordAddress = nullptr;
+#if ION_STORAGE_INDEX
+  if (m_index.isValid() && index >= 0) {
+    int numberOfRecords = m_index.numberOfRecordsWithExtension(extension);
+    int i = 0;
+    if (filter == ExtensionOnlyFilter) {
+      // Every record of the extension passes, skip the previous ones
+      i = index;
+      currentIndex = index - 1;
+    }
+    for (; i < numberOfRecords; i++) {
+      char *p =
+          m_buffer + m_index.offsetOfRecordWithExtensionAtIndex(extension, i);
+      Record::Name currentName = nameOfRecordStarting(p);
+      if (filter(currentName, auxiliary) && ++currentIndex == index) {
+        recordAddress = p;
+        name = currentName;
+        break;
+      }
+    }
+  } else
+#endif
   for (char *p : *this) {
     Record::Name currentName = nameOfRecordStarting(p);
     assert(currentName.extension);
@@ -341,7 +419,8 @@ FileSystem::FileSystem()
       m_magicFooter(Magic),
       m_delegate(nullptr),
       m_lastRecordRetrieved(nullptr),
-      m_lastRecordRetrievedPointer(nullptr) {
+      m_lastRecordRetrievedPointer(nullptr),
+      m_version(1) {
   assert(m_magicHeader == Magic);
   assert(m_magicFooter == Magic);
   // Set the size of the first record to 0
@@ -387,6 +466,9 @@ Record::ErrorStatus FileSystem::setNameOfRecord(Record *record,
     overrideSizeAtPosition(p, newRecordSize);
     char *namePosition = p + sizeof(record_size_t);
     overrideNameAtPosition(namePosition, name);
+#if ION_STORAGE_INDEX
+    m_index.rename(p - m_buffer, newRecord, name.extension);
+#endif
     // Recompute the CRC32
     *record = newRecord;
     notifyChangeToDelegate(newRecord);
@@ -451,8 +533,20 @@ bool FileSystem::destroyRecord(Record record, bool notifyDelegate) {
   if (p) {
     record_size_t previousRecordSize = sizeOfRecordStarting(p);
     slideBuffer(p + previousRecordSize, -previousRecordSize);
+#if ION_STORAGE_INDEX
+    if (m_index.isValid()) {
+      /* The next record now starts at p too, the destroyed one comes first in
+       * the index. */
+      m_index.remove(p - m_buffer);
+    } else {
+      // There may be few enough records left to index them again
+      rebuildIndex();
+    }
+#endif
     if (notifyDelegate) {
       notifyChangeToDelegate();
+    } else {
+      m_version++;
     }
   }
   return true;
@@ -466,6 +560,18 @@ char *FileSystem::pointerOfRecord(const Record record) const {
     assert(m_lastRecordRetrievedPointer);
     return m_lastRecordRetrievedPointer;
   }
+#if ION_STORAGE_INDEX
+  if (m_index.isValid()) {
+    int offset = m_index.offsetOfRecord(record);
+    if (offset == RecordIndex::k_noOffset) {
+      return nullptr;
+    }
+    char *p = const_cast<char *>(m_buffer) + offset;
+    m_lastRecordRetrieved = record;
+    m_lastRecordRetrievedPointer = p;
+    return p;
+  }
+#endif
   for (char *p : *this) {
     Record currentRecord(nameOfRecordStarting(p));
     if (record == currentRecord) {
@@ -527,6 +633,12 @@ bool FileSystem::isNameOfRecordTaken(Record r, const Record *recordToExclude) {
      * name is nullptr. */
     return true;
   }
+#if ION_STORAGE_INDEX
+  if (m_index.isValid()) {
+    return m_index.offsetOfRecord(r) != RecordIndex::k_noOffset &&
+           !(recordToExclude && r == *recordToExclude);
+  }
+#endif
   for (char *p : *this) {
     Record s(nameOfRecordStarting(p));
     if (recordToExclude && s == *recordToExclude) {
@@ -540,6 +652,15 @@ bool FileSystem::isNameOfRecordTaken(Record r, const Record *recordToExclude) {
 }
 
 char *FileSystem::endBuffer() {
+#if ION_STORAGE_INDEX
+  if (m_index.isValid()) {
+    int lastOffset = m_index.lastOffset();
+    if (lastOffset == RecordIndex::k_noOffset) {
+      return m_buffer;
+    }
+    return m_buffer + lastOffset + sizeOfRecordStarting(m_buffer + lastOffset);
+  }
+#endif
   char *currentBuffer = m_buffer;
   for (char *p : *this) {
     currentBuffer += sizeOfRecordStarting(p);
@@ -557,6 +678,9 @@ bool FileSystem::slideBuffer(char *position, int delta) {
   }
   memmove(position + delta, position,
           endBuffer() + sizeof(record_size_t) - position);
+#if ION_STORAGE_INDEX
+  m_index.shift(position - m_buffer, delta);
+#endif
   return true;
 }
 
@@ -571,6 +695,36 @@ Record FileSystem::privateRecordBasedNamedWithExtensions(
           numberOfExtensions, extensionResult)) {
     return m_lastRecordRetrieved;
   }
+#if ION_STORAGE_INDEX
+  if (m_index.isValid()) {
+    /* Look up each candidate name, the first one in the storage is the one
+     * the scan below would find. */
+    int firstOffset = RecordIndex::k_noOffset;
+    for (size_t i = 0; i < numberOfExtensions; i++) {
+      Record::Name name = {baseName, static_cast<size_t>(baseNameLength),
+                           extensions[i]};
+      int offset = m_index.offsetOfRecord(Record(name));
+      if (offset != RecordIndex::k_noOffset &&
+          (firstOffset == RecordIndex::k_noOffset || offset < firstOffset) &&
+          recordNameHasBaseNameAndOneOfTheseExtensions(
+              nameOfRecordStarting(m_buffer + offset), baseName,
+              baseNameLength, extensions + i, 1, nullptr)) {
+        firstOffset = offset;
+      }
+    }
+    if (firstOffset != RecordIndex::k_noOffset) {
+      Record::Name name = nameOfRecordStarting(m_buffer + firstOffset);
+      recordNameHasBaseNameAndOneOfTheseExtensions(
+          name, baseName, baseNameLength, extensions, numberOfExtensions,
+          extensionResult);
+      return Record(name);
+    }
+    if (extensionResult) {
+      *extensionResult = nullptr;
+    }
+    return Record();
+  }
+#endif
   for (char *p : *this) {
     Record::Name currentName = nameOfRecordStarting(p);
     if (recordNameHasBaseNameAndOneOfTheseExtensions(
@@ -605,6 +759,21 @@ bool FileSystem::recordNameHasBaseNameAndOneOfTheseExtensions(
   return false;
 }
 
+#if ION_STORAGE_INDEX
+void FileSystem::indexRecordStarting(char *start) {
+  Record::Name name = nameOfRecordStarting(start);
+  m_index.insert(start - m_buffer, Record(name),
+                 Record::NameIsEmpty(name) ? nullptr : name.extension);
+}
+
+void FileSystem::rebuildIndex() {
+  m_index.reset();
+  for (char *p : *this) {
+    indexRecordStarting(p);
+  }
+}
+#endif
+
 FileSystem::RecordIterator &FileSystem::RecordIterator::operator++() {
   assert(m_recordStart);
   record_size_t size = StorageHelper::unalignedShort(m_recordStart);
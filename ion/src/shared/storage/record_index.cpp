@@ -0,0 +1,186 @@
+#include <assert.h>
+#include <ion/storage/record_index.h>
+#include <string.h>
+
+#if ION_STORAGE_INDEX
+
+namespace Ion {
+
+namespace Storage {
+
+void RecordIndex::reset() {
+  m_numberOfRecords = 0;
+  m_numberOfExtensions = 0;
+  m_isValid = true;
+  m_isDirty = true;
+}
+
+void RecordIndex::insert(uint16_t offset, Record record,
+                         const char* extension) {
+  if (!m_isValid) {
+    return;
+  }
+  // Records with a non-compliant name have no extension
+  uint8_t extensionId =
+      extension ? idOfExtension(extension, true) : k_noExtension;
+  if (m_numberOfRecords == k_maxNumberOfRecords ||
+      (extension && extensionId == k_noExtension)) {
+    invalidate();
+    return;
+  }
+  int position = m_numberOfRecords;
+  while (position > 0 && m_offsets[position - 1] > offset) {
+    position--;
+  }
+  int numberOfMovedRecords = m_numberOfRecords - position;
+  memmove(m_offsets + position + 1, m_offsets + position,
+          numberOfMovedRecords * sizeof(m_offsets[0]));
+  memmove(m_records + position + 1, m_records + position,
+          numberOfMovedRecords * sizeof(m_records[0]));
+  memmove(m_extensionIds + position + 1, m_extensionIds + position,
+          numberOfMovedRecords * sizeof(m_extensionIds[0]));
+  m_offsets[position] = offset;
+  m_records[position] = record;
+  m_extensionIds[position] = extensionId;
+  m_numberOfRecords++;
+  m_isDirty = true;
+}
+
+void RecordIndex::remove(uint16_t offset) {
+  if (!m_isValid) {
+    return;
+  }
+  int position = positionOfOffset(offset);
+  assert(position >= 0);
+  int numberOfMovedRecords = m_numberOfRecords - position - 1;
+  memmove(m_offsets + position, m_offsets + position + 1,
+          numberOfMovedRecords * sizeof(m_offsets[0]));
+  memmove(m_records + position, m_records + position + 1,
+          numberOfMovedRecords * sizeof(m_records[0]));
+  memmove(m_extensionIds + position, m_extensionIds + position + 1,
+          numberOfMovedRecords * sizeof(m_extensionIds[0]));
+  m_numberOfRecords--;
+  m_isDirty = true;
+}
+
+void RecordIndex::rename(uint16_t offset, Record record,
+                         const char* extension) {
+  remove(offset);
+  insert(offset, record, extension);
+}
+
+void RecordIndex::shift(uint16_t offset, int delta) {
+  if (!m_isValid || delta == 0) {
+    return;
+  }
+  for (int i = m_numberOfRecords - 1; i >= 0 && m_offsets[i] >= offset; i--) {
+    m_offsets[i] += delta;
+  }
+}
+
+int RecordIndex::offsetOfRecord(Record record) {
+  assert(m_isValid);
+  updateLookupTables();
+  for (uint32_t slot = Hash(record) & (k_hashTableSize - 1);
+       m_hashTable[slot] != 0; slot = (slot + 1) & (k_hashTableSize - 1)) {
+    int position = m_hashTable[slot] - 1;
+    if (m_records[position] == record) {
+      return m_offsets[position];
+    }
+  }
+  return k_noOffset;
+}
+
+int RecordIndex::numberOfRecordsWithExtension(const char* extension) {
+  assert(m_isValid);
+  uint8_t extensionId = idOfExtension(extension, false);
+  if (extensionId == k_noExtension) {
+    return 0;
+  }
+  updateLookupTables();
+  return m_firstPositionOfExtension[extensionId + 1] -
+         m_firstPositionOfExtension[extensionId];
+}
+
+int RecordIndex::offsetOfRecordWithExtensionAtIndex(const char* extension,
+                                                    int index) {
+  if (index < 0 || index >= numberOfRecordsWithExtension(extension)) {
+    return k_noOffset;
+  }
+  uint8_t extensionId = idOfExtension(extension, false);
+  return m_offsets[m_positionsByExtension
+                       [m_firstPositionOfExtension[extensionId] + index]];
+}
+
+int RecordIndex::positionOfOffset(uint16_t offset) const {
+  int lower = 0;
+  int upper = m_numberOfRecords;
+  while (lower < upper) {
+    int middle = (lower + upper) / 2;
+    if (m_offsets[middle] < offset) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
+  return lower < m_numberOfRecords && m_offsets[lower] == offset ? lower : -1;
+}
+
+uint8_t RecordIndex::idOfExtension(const char* extension, bool intern) {
+  for (int i = 0; i < m_numberOfExtensions; i++) {
+    if (strcmp(m_extensions[i], extension) == 0) {
+      return i;
+    }
+  }
+  if (!intern || m_numberOfExtensions == k_maxNumberOfExtensions ||
+      strlen(extension) > k_maxExtensionLength) {
+    return k_noExtension;
+  }
+  strlcpy(m_extensions[m_numberOfExtensions], extension,
+          k_maxExtensionLength + 1);
+  m_isDirty = true;
+  return m_numberOfExtensions++;
+}
+
+void RecordIndex::updateLookupTables() {
+  if (!m_isDirty) {
+    return;
+  }
+  memset(m_hashTable, 0, sizeof(m_hashTable));
+  for (int position = 0; position < m_numberOfRecords; position++) {
+    if (m_extensionIds[position] == k_noExtension) {
+      continue;
+    }
+    uint32_t slot = Hash(m_records[position]) & (k_hashTableSize - 1);
+    while (m_hashTable[slot] != 0) {
+      slot = (slot + 1) & (k_hashTableSize - 1);
+    }
+    m_hashTable[slot] = position + 1;
+  }
+  // Counting sort of the positions by extension
+  memset(m_firstPositionOfExtension, 0, sizeof(m_firstPositionOfExtension));
+  for (int position = 0; position < m_numberOfRecords; position++) {
+    if (m_extensionIds[position] != k_noExtension) {
+      m_firstPositionOfExtension[m_extensionIds[position] + 1]++;
+    }
+  }
+  for (int i = 0; i < m_numberOfExtensions; i++) {
+    m_firstPositionOfExtension[i + 1] += m_firstPositionOfExtension[i];
+  }
+  uint16_t nextPositionOfExtension[k_maxNumberOfExtensions];
+  memcpy(nextPositionOfExtension, m_firstPositionOfExtension,
+         sizeof(nextPositionOfExtension));
+  for (int position = 0; position < m_numberOfRecords; position++) {
+    uint8_t extensionId = m_extensionIds[position];
+    if (extensionId != k_noExtension) {
+      m_positionsByExtension[nextPositionOfExtension[extensionId]++] = position;
+    }
+  }
+  m_isDirty = false;
+}
+
+}  // namespace Storage
+
+}  // namespace Ion
+
+#endif
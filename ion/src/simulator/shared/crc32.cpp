@@ -1,26 +1,72 @@
 #include <ion/crc.h>
+#include <string.h>
 
 namespace Ion {
 
 constexpr size_t k_uint32ByteLength = sizeof(uint32_t) / sizeof(uint8_t);
 
+/* Slicing-by-8: m_tables[k][b] is the CRC of the byte b followed by k zero
+ * bytes, which lets the CRC eat 8 bytes with 8 independent table lookups
+ * instead of 64 bitwise steps. */
+class CRC32Tables {
+ public:
+  constexpr static int k_numberOfTables = 8;
+  constexpr CRC32Tables() : m_tables() {
+    for (int b = 0; b < 256; b++) {
+      m_tables[0][b] = crc32EatByte(0, b);
+    }
+    for (int k = 1; k < k_numberOfTables; k++) {
+      for (int b = 0; b < 256; b++) {
+        uint32_t previous = m_tables[k - 1][b];
+        m_tables[k][b] = (previous << 8) ^ m_tables[0][previous >> 24];
+      }
+    }
+  }
+  uint32_t eat(int table, uint32_t crc, int shift) const {
+    return m_tables[table][(crc >> shift) & 0xFF];
+  }
+
+ private:
+  uint32_t m_tables[k_numberOfTables][256];
+};
+
+constexpr static CRC32Tables k_tables;
+
+static uint32_t loadDoubleWord(const uint8_t *data) {
+  // Avoid alignment issues when building for emscripten platform
+  uint32_t word;
+  memcpy(&word, data, k_uint32ByteLength);
+  return word;
+}
+
 uint32_t crc32Byte(const uint8_t *data, size_t length) {
   if (length == 0) {
     return 0;
   }
   assert(data != nullptr);
   uint32_t crc = 0xFFFFFFFF;
-  size_t lengthInDoubleWords = length / k_uint32ByteLength;
-
-  for (size_t i = 0; i < lengthInDoubleWords; i++) {
-    // FIXME: Assumes little-endian byte order!
-    for (int j = k_uint32ByteLength - 1; j >= 0; j--) {
-      // scan byte by byte to avoid alignment issue when building for emscripten
-      // platform
-      crc = crc32EatByte(crc, data[i * k_uint32ByteLength + j]);
-    }
+  /* Bytes are eaten by 32 bits values, most significant byte first.
+   * FIXME: Assumes little-endian byte order! */
+  constexpr size_t k_sliceLength = 2 * k_uint32ByteLength;
+  size_t lengthInSlices = length / k_sliceLength;
+  for (size_t i = 0; i < lengthInSlices; i++) {
+    crc ^= loadDoubleWord(data);
+    uint32_t next = loadDoubleWord(data + k_uint32ByteLength);
+    crc = k_tables.eat(7, crc, 24) ^ k_tables.eat(6, crc, 16) ^
+          k_tables.eat(5, crc, 8) ^ k_tables.eat(4, crc, 0) ^
+          k_tables.eat(3, next, 24) ^ k_tables.eat(2, next, 16) ^
+          k_tables.eat(1, next, 8) ^ k_tables.eat(0, next, 0);
+    data += k_sliceLength;
+  }
+  length -= lengthInSlices * k_sliceLength;
+  if (length >= k_uint32ByteLength) {
+    crc ^= loadDoubleWord(data);
+    crc = k_tables.eat(3, crc, 24) ^ k_tables.eat(2, crc, 16) ^
+          k_tables.eat(1, crc, 8) ^ k_tables.eat(0, crc, 0);
+    data += k_uint32ByteLength;
+    length -= k_uint32ByteLength;
   }
-  for (size_t i = lengthInDoubleWords * k_uint32ByteLength; i < length; i++) {
+  for (size_t i = 0; i < length; i++) {
     crc = crc32EatByte(crc, data[i]);
   }
   return crc;
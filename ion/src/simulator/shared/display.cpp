@@ -22,6 +22,8 @@ void init(SDL_Renderer* renderer) {
   sFramebufferTexture = SDL_CreateTexture(
       renderer, texturePixelFormat, SDL_TEXTUREACCESS_STREAMING,
       Ion::Display::Width, Ion::Display::Height);
+  // The content of a new texture is undefined
+  Framebuffer::invalidate();
 }
 
 void shutdown() {
@@ -30,8 +32,16 @@ void shutdown() {
 }
 
 void draw(SDL_Renderer* renderer, SDL_Rect* rect) {
-  SDL_UpdateTexture(sFramebufferTexture, nullptr, Framebuffer::address(),
-                    sizeof(KDColor) * Ion::Display::Width);
+  int numberOfDirtyRects = Framebuffer::numberOfDirtyRects();
+  for (int i = 0; i < numberOfDirtyRects; i++) {
+    KDRect r = Framebuffer::dirtyRect(i);
+    SDL_Rect textureRect = {r.x(), r.y(), r.width(), r.height()};
+    SDL_UpdateTexture(sFramebufferTexture, &textureRect,
+                      Framebuffer::address() + r.y() * Ion::Display::Width +
+                          r.x(),
+                      sizeof(KDColor) * Ion::Display::Width);
+  }
+  Framebuffer::clearDirtyRects();
   SDL_RenderCopy(renderer, sFramebufferTexture, nullptr, rect);
 }
 
@@ -15,6 +15,7 @@
 #include <algorithm>
 
 #include "haptics.h"
+#include "timing.h"
 #include "ion/src/simulator/shared/clipboard_helper.h"
 
 #if ESCHER_LOG_EVENTS_NAME
@@ -52,9 +53,13 @@ void openURL(const char *url) { SDL_OpenURL(url); }
 bool waitForInterruptingEvent(int maximumDelay, int *timeout) {
   Keyboard::scan();
   /* As pressing keys on the simulator does not generate interruptions, we need
-   * to poll the keyboard more regularly than on the device. */
+   * to poll the keyboard more regularly than on the device. The virtual clock
+   * only runs headless, where no key is pressed: the wait ends at the
+   * deadline. */
   constexpr int simulatorDelay = 10;
-  maximumDelay = std::min(simulatorDelay, maximumDelay);
+  if (!Simulator::Timing::hasVirtualClock()) {
+    maximumDelay = std::min(simulatorDelay, maximumDelay);
+  }
   if (*timeout < maximumDelay) {
     Timing::msleep(*timeout);
     *timeout = 0;
@@ -1,5 +1,6 @@
 #include "framebuffer.h"
 
+#include <assert.h>
 #include <ion/display.h>
 #include <kandinsky/color.h>
 #include <kandinsky/framebuffer.h>
@@ -11,15 +12,53 @@
  * the GPU's memory. Reading data back from a texture is not possible, so we
  * simply maintain a framebuffer in RAM since Ion::Display::pullRect expects to
  * be able to read pixel data back.
- * A side effect is that we rewrite the whole texture when redrawing the screen.
- * This might not be the most efficient way since sending pixels to the GPU is
- * rather expensive.
- * This is also very useful when running headless because we can easily log the
- * framebuffer to a PNG file. */
+ * Sending pixels to the GPU is rather expensive, so we keep track of the
+ * regions written since the last upload and only rewrite these parts of the
+ * texture when redrawing the screen.
+ * The RAM framebuffer is also very useful when running headless because we can
+ * easily log the framebuffer to a PNG file. */
 
 static KDColor sPixels[Ion::Display::Width * Ion::Display::Height];
 static bool sFrameBufferActive = false;
 
+/* Most redraws are small (a blinking cursor, a highlighted cell...), a handful
+ * of rectangles is enough to describe them. When the list is full, the new
+ * rectangle is merged with the one whose union with it is the smallest. */
+static KDRect
+    sDirtyRects[Ion::Simulator::Framebuffer::k_maxNumberOfDirtyRects] = {
+        KDRectZero, KDRectZero, KDRectZero, KDRectZero};
+static int sNumberOfDirtyRects = 0;
+
+static int area(KDRect r) { return r.width() * r.height(); }
+
+static void markDirty(KDRect r) {
+  r = r.intersectedWith(KDRectScreen);
+  if (r.isEmpty()) {
+    return;
+  }
+  int bestIndex = -1;
+  int bestGrowth = 0;
+  for (int i = 0; i < sNumberOfDirtyRects; i++) {
+    KDRect u = sDirtyRects[i].unionedWith(r);
+    int growth = area(u) - area(sDirtyRects[i]) - area(r);
+    if (growth <= 0) {
+      // Overlapping or adjacent rectangles are merged for free
+      sDirtyRects[i] = u;
+      return;
+    }
+    if (bestIndex < 0 || growth < bestGrowth) {
+      bestIndex = i;
+      bestGrowth = growth;
+    }
+  }
+  if (sNumberOfDirtyRects <
+      Ion::Simulator::Framebuffer::k_maxNumberOfDirtyRects) {
+    sDirtyRects[sNumberOfDirtyRects++] = r;
+    return;
+  }
+  sDirtyRects[bestIndex] = sDirtyRects[bestIndex].unionedWith(r);
+}
+
 namespace Ion {
 namespace Display {
 
@@ -29,6 +68,7 @@ static KDFrameBuffer sFrameBuffer =
 void pushRect(KDRect r, const KDColor* pixels) {
   if (sFrameBufferActive) {
     Simulator::Window::setNeedsRefresh();
+    markDirty(r);
     sFrameBuffer.pushRect(r, pixels);
   }
 }
@@ -36,6 +76,7 @@ void pushRect(KDRect r, const KDColor* pixels) {
 void pushRectUniform(KDRect r, KDColor c) {
   if (sFrameBufferActive) {
     Simulator::Window::setNeedsRefresh();
+    markDirty(r);
     sFrameBuffer.pushRectUniform(r, c);
   }
 }
@@ -57,6 +98,20 @@ const KDColor* address() { return sPixels; }
 
 void setActive(bool enabled) { sFrameBufferActive = enabled; }
 
+void invalidate() {
+  sDirtyRects[0] = KDRectScreen;
+  sNumberOfDirtyRects = 1;
+}
+
+int numberOfDirtyRects() { return sNumberOfDirtyRects; }
+
+KDRect dirtyRect(int index) {
+  assert(index < sNumberOfDirtyRects);
+  return sDirtyRects[index];
+}
+
+void clearDirtyRects() { sNumberOfDirtyRects = 0; }
+
 }  // namespace Framebuffer
 }  // namespace Simulator
 }  // namespace Ion
@@ -2,13 +2,23 @@
 #define ION_SIMULATOR_FRAMEBUFFER_H
 
 #include <kandinsky/color.h>
+#include <kandinsky/rect.h>
 
 namespace Ion {
 namespace Simulator {
 namespace Framebuffer {
 
+constexpr int k_maxNumberOfDirtyRects = 4;
+
 const KDColor* address();
 void setActive(bool enabled);
+// Mark the whole framebuffer as needing to be uploaded
+void invalidate();
+/* Regions written since the last call to clearDirtyRects, at most
+ * k_maxNumberOfDirtyRects of them. */
+int numberOfDirtyRects();
+KDRect dirtyRect(int index);
+void clearDirtyRects();
 
 }  // namespace Framebuffer
 }  // namespace Simulator
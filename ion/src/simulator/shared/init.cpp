@@ -10,4 +10,12 @@ void Init() {
   Storage::FileSystem::sharedFileSystem.init();
 }
 
+#if ION_SIMULATOR_FILES
+void Shutdown() {
+  Storage::FileSystem::sharedFileSystem.deinit();
+  Events::SharedState.deinit();
+  Events::SharedModifierState.deinit();
+}
+#endif
+
 }  // namespace Ion
@@ -4,6 +4,7 @@
 #include <ion/keyboard/layout_events.h>
 #endif
 #include <ion/src/shared/init.h>
+#include <stdio.h>
 
 #include <algorithm>
 #include <array>
@@ -15,17 +16,24 @@
 #include "random.h"
 #include "state_file.h"
 #include "telemetry.h"
+#include "timing.h"
 #include "window.h"
 #ifndef __WIN32__
 #include <signal.h>
 #include <sys/resource.h>
 #endif
+#if defined(__linux__)
+#include <sys/personality.h>
+#include <unistd.h>
+#endif
 #if ION_SIMULATOR_FILES
+#include <ion/exam_bytes.h>
 #include <signal.h>
-#include <stdio.h>
+#include <string.h>
 
 #include "actions.h"
 #include "screenshot.h"
+#include "storage_image.h"
 extern "C" {
 extern char *eadk_external_data;
 extern size_t eadk_external_data_size;
@@ -37,6 +45,14 @@ constexpr static const char *k_loadStateFileKeys[] = {"--load-state-file",
                                                       "-l"};
 constexpr static const char *k_headlessFlags[] = {"--headless", "-h"};
 constexpr static const char *k_languageFlag = "--language";
+constexpr static const char *k_loadStorageImageKey = "--load-storage-image";
+constexpr static const char *k_saveStorageImageKey = "--save-storage-image";
+constexpr static const char *k_loadSnapshotKey = "--load-snapshot";
+constexpr static const char *k_saveSnapshotKey = "--save-snapshot";
+constexpr static const char *k_batchKey = "--batch";
+constexpr static const char *k_benchmarkKey = "--benchmark";
+constexpr static const char *k_benchmarkScenarioKey = "--benchmark-scenario";
+constexpr static const char *k_redrawTelemetryKey = "--redraw-telemetry";
 
 /* The Args class allows parsing and editing command-line arguments
  * The editing part allows us to add/remove arguments before forwarding them to
@@ -120,6 +136,20 @@ std::vector<const char *>::const_iterator Args::find(const char *name) const {
 }
 
 #if ION_SIMULATOR_FILES
+/* Records hold Poincare trees, whose nodes start with pointers to virtual
+ * tables. The storage of a run is thus only valid in runs where the binary is
+ * loaded at the same address, which requires to disable the randomization of
+ * the address space. Restart the process without it if needed. */
+static inline void disable_address_space_randomization(char *argv[]) {
+#if defined(__linux__)
+  int persona = personality(0xffffffff);
+  if (persona != -1 && !(persona & ADDR_NO_RANDOMIZE) &&
+      personality(persona | ADDR_NO_RANDOMIZE) != -1) {
+    execv("/proc/self/exe", argv);
+  }
+#endif
+}
+
 static inline int load_eadk_external_data(const char *path) {
   if (path == nullptr) {
     return 0;
@@ -155,9 +185,60 @@ static inline int load_eadk_external_data(const char *path) {
 
 using namespace Ion::Simulator;
 
+#if ION_SIMULATOR_FILES
+/* Replay the state files listed in a manifest, one path per line, and print
+ * the CRC32 of the screenshots of each. ion_main runs once per state file, on
+ * globals reset to the state of a new process. */
+static inline int run_batch(const char *manifest, const Args &args) {
+  FILE *f = fopen(manifest, "r");
+  if (f == nullptr) {
+    fprintf(stderr, "Error loading batch manifest %s\n", manifest);
+    return -1;
+  }
+  constexpr size_t k_pathSize = 1024;
+  char stateFile[k_pathSize];
+  while (fgets(stateFile, sizeof(stateFile), f) != nullptr) {
+    stateFile[strcspn(stateFile, "\r\n")] = 0;
+    if (stateFile[0] == 0) {
+      continue;
+    }
+    // The exam mode, the screen and the clock outlive Ion::Init
+    Ion::Init();
+    Ion::ExamBytes::write(0);
+    Timing::resetVirtualClock();
+    Ion::Display::pushRectUniform(KDRectScreen, KDColorBlack);
+    Journal::replayJournal()->setStartingLanguage("");
+    StateFile::load(stateFile, false);
+    const char *language = Journal::replayJournal()->startingLanguage();
+    // Like a single state file, each one sets its language
+    Args scenarioArgs = args;
+    scenarioArgs.pop(k_languageFlag);
+    scenarioArgs.push(k_languageFlag, language[0] != 0 ? language : "none");
+    if (args.has(k_benchmarkKey) || args.has(k_redrawTelemetryKey)) {
+      scenarioArgs.pop(k_benchmarkScenarioKey);
+      scenarioArgs.push(k_benchmarkScenarioKey, stateFile);
+    }
+    Screenshot::commandlineScreenshot()->init(nullptr, true, true);
+    Ion::Console::writeLine(stateFile, false);
+    Ion::Console::writeLine(": ", false);
+    ion_main(scenarioArgs.argc(), scenarioArgs.argv());
+    Ion::Shutdown();
+  }
+  fclose(f);
+  return 0;
+}
+#endif
+
 int main(int argc, char *argv[]) {
   Args args(argc, argv);
 
+#if ION_SIMULATOR_FILES
+  if (args.has(k_loadStorageImageKey) || args.has(k_saveStorageImageKey) ||
+      args.has(k_loadSnapshotKey) || args.has(k_saveSnapshotKey)) {
+    disable_address_space_randomization(argv);
+  }
+#endif
+
 #ifndef __WIN32__
   if (args.popFlag("--limit-stack-usage")) {
     // Limit stack usage
@@ -168,6 +249,9 @@ int main(int argc, char *argv[]) {
 #endif
 
 #if ION_SIMULATOR_FILES
+  /* Option to replay many state files in a single process:
+   * $ ./epsilon.bin --headless --batch manifest.txt */
+  const char *batchManifest = args.pop(k_batchKey);
   const char *stateFile =
       args.pop(k_loadStateFileKeys, std::size(k_loadStateFileKeys));
   if (stateFile) {
@@ -190,6 +274,10 @@ int main(int argc, char *argv[]) {
       replayJournalLanguage = "none";
     }
     args.push(k_languageFlag, replayJournalLanguage);
+    if ((args.has(k_benchmarkKey) || args.has(k_redrawTelemetryKey)) &&
+        !args.has(k_benchmarkScenarioKey)) {
+      args.push(k_benchmarkScenarioKey, stateFile);
+    }
   }
 
   const char *screenshotPath = args.pop("--take-screenshot");
@@ -209,6 +297,9 @@ int main(int argc, char *argv[]) {
                                                               true);
   }
 
+  const char *loadStorageImagePath = args.pop(k_loadStorageImageKey);
+  const char *saveStorageImagePath = args.pop(k_saveStorageImageKey);
+
 #if ESCHER_LOG_EVENTS_NAME
   bool doNotLogEvents = args.popFlag("--hide-events");
   if (doNotLogEvents) {
@@ -221,12 +312,24 @@ int main(int argc, char *argv[]) {
 #endif
 #endif
 
-  // Default language
-  if (!args.has(k_languageFlag)) {
+  // Default language, a machine snapshot comes with its own
+  if (!args.has(k_languageFlag) && !args.has(k_loadSnapshotKey)) {
     args.push(k_languageFlag, Platform::languageCode());
   }
 
   bool headless = args.popFlags(k_headlessFlags, std::size(k_headlessFlags));
+  bool framePacing = args.popFlag("--frame-pacing");
+
+  /* Option to replace the clock with a virtual one, which only advances when
+   * the simulator waits or reads it:
+   * $ ./epsilon.bin --headless --virtual-clock -l scenario.nws */
+  if (args.popFlag("--virtual-clock")) {
+    if (!headless) {
+      fprintf(stderr, "Error: the virtual clock only runs headless\n");
+      return -1;
+    }
+    Timing::enableVirtualClock();
+  }
 
   Random::init();
   if (!headless) {
@@ -238,7 +341,7 @@ int main(int argc, char *argv[]) {
 #if EPSILON_TELEMETRY
     Telemetry::init();
 #endif
-    Window::init();
+    Window::init(framePacing);
     Haptics::init();
   }
 
@@ -261,11 +364,27 @@ int main(int argc, char *argv[]) {
     }
     nwb_main(args.argc(), args.argv());
     dlclose(handle);
+  } else if (batchManifest) {
+    if (!headless) {
+      fprintf(stderr, "Error: batches only run headless\n");
+      return -1;
+    }
+    return run_batch(batchManifest, args);
   } else {
 #endif
     Ion::Init();
+#if ION_SIMULATOR_FILES
+    if (loadStorageImagePath && !StorageImage::load(loadStorageImagePath)) {
+      fprintf(stderr, "Error loading storage image %s\n",
+              loadStorageImagePath);
+      return -1;
+    }
+#endif
     ion_main(args.argc(), args.argv());
 #if ION_SIMULATOR_FILES
+    if (saveStorageImagePath && !StorageImage::save(saveStorageImagePath)) {
+      fprintf(stderr, "Error saving storage image %s\n", saveStorageImagePath);
+    }
   }
 #endif
   if (!headless) {
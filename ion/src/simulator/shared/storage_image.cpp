@@ -0,0 +1,148 @@
+#include "storage_image.h"
+
+#include <ion.h>
+#include <ion/storage/file_system.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using Ion::Storage::FileSystem;
+
+namespace Ion {
+namespace Simulator {
+namespace StorageImage {
+
+/* File format:
+ *   "NWSI" : Magic
+ * + "XXXXXXXX" : Software version
+ * + "XXXXXXXX" : Patch level, the commit the binary was built from
+ * + 0x01 : Image format version
+ * + Addresses of the code and of the storage, to check the layout of the
+ *   process
+ * + Storage image */
+
+constexpr static const char* k_magic = "NWSI";
+constexpr static size_t k_magicLength = 4;
+constexpr static size_t k_versionLength = 8;
+constexpr static uint8_t k_formatVersion = 1;
+
+struct Header {
+  char magic[k_magicLength];
+  char version[k_versionLength];
+  char patchLevel[k_versionLength];
+  uint8_t formatVersion;
+  uint64_t codeAddress;
+  uint64_t storageAddress;
+};
+
+constexpr static size_t k_fileSize = sizeof(Header) + FileSystem::k_imageSize;
+
+static void InitHeader(Header* header) {
+  memset(header, 0, sizeof(Header));
+  memcpy(header->magic, k_magic, k_magicLength);
+  strncpy(header->version, Ion::epsilonVersion(), k_versionLength);
+  strncpy(header->patchLevel, Ion::patchLevel(), k_versionLength);
+  header->formatVersion = k_formatVersion;
+  header->codeAddress = reinterpret_cast<uintptr_t>(&load);
+  header->storageAddress =
+      reinterpret_cast<uintptr_t>(FileSystem::sharedFileSystem->image());
+}
+
+/* The records hold pointers to code, an image saved by another binary or with
+ * another layout of the process would crash the apps later on. */
+static bool LoadImageWithHeader(const void* file) {
+  Header expectedHeader;
+  InitHeader(&expectedHeader);
+  return memcmp(file, &expectedHeader, sizeof(Header)) == 0 &&
+         FileSystem::sharedFileSystem->loadImage(
+             static_cast<const char*>(file) + sizeof(Header));
+}
+
+#ifndef _WIN32
+
+/* The image is mapped rather than read, the kernel shares its pages between
+ * the runs that load it. */
+
+bool load(const char* filename) {
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 ||
+      static_cast<size_t>(status.st_size) != k_fileSize) {
+    close(fd);
+    return false;
+  }
+  void* file = mmap(nullptr, k_fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (file == MAP_FAILED) {
+    return false;
+  }
+  bool result = LoadImageWithHeader(file);
+  munmap(file, k_fileSize);
+  return result;
+}
+
+bool save(const char* filename) {
+  int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  if (ftruncate(fd, k_fileSize) != 0) {
+    close(fd);
+    return false;
+  }
+  void* file = mmap(nullptr, k_fileSize, PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (file == MAP_FAILED) {
+    return false;
+  }
+  Header header;
+  InitHeader(&header);
+  memcpy(file, &header, sizeof(Header));
+  memcpy(static_cast<char*>(file) + sizeof(Header),
+         FileSystem::sharedFileSystem->image(), FileSystem::k_imageSize);
+  munmap(file, k_fileSize);
+  return true;
+}
+
+#else
+
+bool load(const char* filename) {
+  FILE* f = fopen(filename, "rb");
+  if (!f) {
+    return false;
+  }
+  static char file[k_fileSize];
+  bool result =
+      fread(file, k_fileSize, 1, f) == 1 && LoadImageWithHeader(file);
+  fclose(f);
+  return result;
+}
+
+bool save(const char* filename) {
+  FILE* f = fopen(filename, "wb");
+  if (!f) {
+    return false;
+  }
+  Header header;
+  InitHeader(&header);
+  bool result = fwrite(&header, sizeof(Header), 1, f) == 1 &&
+                fwrite(FileSystem::sharedFileSystem->image(),
+                       FileSystem::k_imageSize, 1, f) == 1;
+  fclose(f);
+  return result;
+}
+
+#endif
+
+}  // namespace StorageImage
+}  // namespace Simulator
+}  // namespace Ion
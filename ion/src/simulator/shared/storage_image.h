@@ -0,0 +1,23 @@
+#ifndef ION_SIMULATOR_STORAGE_IMAGE_H
+#define ION_SIMULATOR_STORAGE_IMAGE_H
+
+namespace Ion {
+namespace Simulator {
+namespace StorageImage {
+
+/* A storage image is a file holding the bytes of the storage, as they are laid
+ * out in memory. Loading one replaces the records of the storage, preferences
+ * included, so that a run can start where a previous one saved its image.
+ * Since records hold pointers to code, an image is only valid for the binary
+ * that saved it, run without address space randomization. The image starts
+ * with the version of the binary and the addresses of its code and storage,
+ * and loading it fails if they do not match. */
+
+bool load(const char* filename);
+bool save(const char* filename);
+
+}  // namespace StorageImage
+}  // namespace Simulator
+}  // namespace Ion
+
+#endif
@@ -1,3 +1,5 @@
+#include "timing.h"
+
 #include <SDL.h>
 #include <ion/timing.h>
 
@@ -6,16 +8,25 @@
 #include "window.h"
 
 static auto start = std::chrono::steady_clock::now();
+static bool sVirtualClock = false;
+static uint64_t sVirtualMillis = 0;
 
 namespace Ion {
 namespace Timing {
 
 uint64_t millis() {
+  if (sVirtualClock) {
+    return sVirtualMillis++;
+  }
   auto elapsed = std::chrono::steady_clock::now() - start;
   return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
 }
 
 void msleep(uint32_t ms) {
+  if (sVirtualClock) {
+    sVirtualMillis += ms;
+    return;
+  }
   if (Simulator::Window::isHeadless()) {
     return;
   }
@@ -23,4 +34,16 @@ void msleep(uint32_t ms) {
 }
 
 }  // namespace Timing
+
+namespace Simulator {
+namespace Timing {
+
+void enableVirtualClock() { sVirtualClock = true; }
+
+bool hasVirtualClock() { return sVirtualClock; }
+
+void resetVirtualClock() { sVirtualMillis = 0; }
+
+}  // namespace Timing
+}  // namespace Simulator
 }  // namespace Ion
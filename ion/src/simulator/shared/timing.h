@@ -0,0 +1,22 @@
+#ifndef ION_SIMULATOR_TIMING_H
+#define ION_SIMULATOR_TIMING_H
+
+namespace Ion {
+namespace Simulator {
+namespace Timing {
+
+/* With a virtual clock, the simulator does not sleep: waiting advances the
+ * clock by the duration of the wait instead. Idle waits end immediately at the
+ * next timer deadline, and each read of the clock advances it by a millisecond
+ * so that loops waiting on it terminate. Headless replays are then faster and
+ * reproducible. */
+void enableVirtualClock();
+bool hasVirtualClock();
+// Restart the virtual clock, for the next state file of a batch
+void resetVirtualClock();
+
+}  // namespace Timing
+}  // namespace Simulator
+}  // namespace Ion
+
+#endif
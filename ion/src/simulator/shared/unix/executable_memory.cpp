@@ -0,0 +1,35 @@
+#include <ion/executable_memory.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+namespace Ion {
+namespace ExecutableMemory {
+
+constexpr static size_t k_size = 256 * 1024;
+constexpr static size_t k_alignment = 16;
+
+static uint8_t* sMemory = nullptr;
+static size_t sUsedSize = 0;
+
+void* allocate(size_t size) {
+  if (sMemory == nullptr) {
+    void* memory = mmap(nullptr, k_size, PROT_READ | PROT_WRITE | PROT_EXEC,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+      return nullptr;
+    }
+    sMemory = static_cast<uint8_t*>(memory);
+  }
+  size = (size + k_alignment - 1) & ~(k_alignment - 1);
+  if (size > k_size - sUsedSize) {
+    return nullptr;
+  }
+  void* block = sMemory + sUsedSize;
+  sUsedSize += size;
+  return block;
+}
+
+void reset() { sUsedSize = 0; }
+
+}  // namespace ExecutableMemory
+}  // namespace Ion
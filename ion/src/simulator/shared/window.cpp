@@ -6,6 +6,7 @@
 #include <stdio.h>
 
 #include "display.h"
+#include "framebuffer.h"
 #include "layout.h"
 #include "platform.h"
 
@@ -16,13 +17,19 @@ namespace Window {
 static SDL_Window* sWindow = nullptr;
 static SDL_Renderer* sRenderer = nullptr;
 static bool sNeedsRefresh = false;
+/* With frame pacing, refreshes requested less than a display period after the
+ * last one are postponed until the next keyboard scan, so that bursts of
+ * redraws are presented at most once per frame. */
+static bool sFramePacing = false;
+static Uint32 sFramePeriod = 0;
+static Uint32 sLastRefreshTime = 0;
 #if EPSILON_SDL_SCREEN_ONLY
 static SDL_Rect sScreenRect;
 #endif
 
 bool isHeadless() { return sWindow == nullptr; }
 
-void init() {
+void init(bool framePacing) {
   if (SDL_Init(SDL_INIT_VIDEO) != 0) {
     SDL_Log("Could not init video");
     return;
@@ -68,6 +75,15 @@ void init() {
   Layout::init(sRenderer);
 #endif
 
+  sFramePacing = framePacing;
+  SDL_DisplayMode displayMode;
+  int refreshRate = 60;
+  if (SDL_GetWindowDisplayMode(sWindow, &displayMode) == 0 &&
+      displayMode.refresh_rate > 0) {
+    refreshRate = displayMode.refresh_rate;
+  }
+  sFramePeriod = 1000 / refreshRate;
+
   didInit(sWindow);
 
   relayout();
@@ -91,6 +107,8 @@ void relayout() {
   Layout::recompute(windowWidth, windowHeight);
 #endif
 
+  // The renderer may have lost the content of its textures
+  Framebuffer::invalidate();
   setNeedsRefresh();
 }
 
@@ -100,6 +118,13 @@ void refresh() {
   if (!sNeedsRefresh || isHeadless()) {
     return;
   }
+  if (sFramePacing) {
+    Uint32 now = SDL_GetTicks();
+    if (now - sLastRefreshTime < sFramePeriod) {
+      return;
+    }
+    sLastRefreshTime = now;
+  }
   sNeedsRefresh = false;
 
 #if EPSILON_SDL_SCREEN_ONLY
@@ -10,7 +10,9 @@ namespace Window {
 constexpr static int perfectWidth = 458;
 constexpr static int perfectHeight = 888;
 
-void init();
+/* If framePacing is set, refreshes are coalesced so that the window is
+ * presented at most once per period of the display. */
+void init(bool framePacing = false);
 void shutdown();
 
 bool isHeadless();
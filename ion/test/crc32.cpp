@@ -13,3 +13,50 @@ QUIZ_CASE(ion_crc32) {
   quiz_assert(Ion::crc32Byte(inputBytes, 6) == 0x7BCD4EB3);
   quiz_assert(Ion::crc32Byte(inputBytes, 8) == 0x72EAD3FB);
 }
+
+static uint32_t referenceCRC32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    for (int j = 3; j >= 0; j--) {
+      crc = Ion::crc32EatByte(crc, data[i + j]);
+    }
+  }
+  for (; i < length; i++) {
+    crc = Ion::crc32EatByte(crc, data[i]);
+  }
+  return crc;
+}
+
+QUIZ_CASE(ion_crc32_lengths_and_alignments) {
+  uint8_t buffer[64];
+  for (size_t i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = 37 * i + 11;
+  }
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t length = 1; length + offset <= sizeof(buffer); length++) {
+      quiz_assert(Ion::crc32Byte(buffer + offset, length) ==
+                  referenceCRC32(buffer + offset, length));
+    }
+  }
+}
+
+#ifndef PLATFORM_DEVICE
+/* The framebuffer sized buffer would take a large part of the device RAM, so
+ * the benchmark only runs on the simulator. */
+QUIZ_CASE(ion_crc32_benchmark) {
+  /* Hash a buffer as large as the framebuffer several times. The duration of
+   * this case is given by the tests report. */
+  constexpr size_t k_length = Ion::Display::Width * Ion::Display::Height;
+  static uint16_t buffer[k_length];
+  for (size_t i = 0; i < k_length; i++) {
+    buffer[i] = i * 2654435761u;
+  }
+  uint32_t crc = Ion::crc32Word(buffer, k_length);
+  quiz_assert(crc == referenceCRC32(reinterpret_cast<uint8_t*>(buffer),
+                                    k_length * sizeof(uint16_t)));
+  for (int i = 0; i < 32; i++) {
+    quiz_assert(Ion::crc32Word(buffer, k_length) == crc);
+  }
+}
+#endif
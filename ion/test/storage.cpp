@@ -749,3 +749,105 @@ QUIZ_CASE(ion_storage_record_name_verifier) {
   recordNameVerifier->unregisterAllRestrictiveExtensions();
   recordNameVerifier->unregisterAllReservedNames();
 }
+
+static void nameOfSmallRecord(char *buffer, char prefix, int i) {
+  buffer[0] = prefix;
+  buffer[1] = '0' + i / 1000;
+  buffer[2] = '0' + (i / 100) % 10;
+  buffer[3] = '0' + (i / 10) % 10;
+  buffer[4] = '0' + i % 10;
+  buffer[5] = 0;
+}
+
+static void assert_small_records_are(const char *extension, int first,
+                                     int step, int number) {
+  Storage::FileSystem *fileSystem = Storage::FileSystem::sharedFileSystem;
+  quiz_assert(fileSystem->numberOfRecordsWithExtension(extension) == number);
+  char baseName[6];
+  for (int i = 0; i < number; i++) {
+    int id = first + i * step;
+    // Every tenth record has been renamed
+    nameOfSmallRecord(baseName, id % 10 == 0 ? 's' : 'r', id);
+    Storage::Record record =
+        fileSystem->recordWithExtensionAtIndex(extension, i);
+    quiz_assert(record ==
+                fileSystem->recordBaseNamedWithExtension(baseName, extension));
+    quiz_assert(strncmp(record.fullName(), baseName, 5) == 0);
+    quiz_assert(*static_cast<const char *>(record.value().buffer) ==
+                static_cast<char>(id));
+  }
+  quiz_assert(fileSystem->recordWithExtensionAtIndex(extension, number)
+                  .isNull());
+}
+
+QUIZ_CASE(ion_storage_many_small_records) {
+  /* Benchmark the lookups in a storage full of small records: the apps
+   * browse the records of an extension by index, in loops. */
+  Storage::FileSystem *fileSystem = Storage::FileSystem::sharedFileSystem;
+  size_t initialAvailableSize = fileSystem->availableSize();
+  const char *extension = "small";
+  constexpr int k_numberOfRecords = 1600;
+  char baseName[6];
+  for (int i = 0; i < k_numberOfRecords; i++) {
+    nameOfSmallRecord(baseName, 'r', i);
+    char data = i;
+    quiz_assert(fileSystem->createRecordWithExtension(
+                    baseName, extension, &data, 1) ==
+                Storage::Record::ErrorStatus::None);
+  }
+  // Rename every tenth record, which keeps its place in the storage
+  for (int i = 0; i < k_numberOfRecords; i += 10) {
+    nameOfSmallRecord(baseName, 'r', i);
+    Storage::Record record =
+        fileSystem->recordBaseNamedWithExtension(baseName, extension);
+    baseName[0] = 's';
+    quiz_assert(Storage::Record::SetBaseNameWithExtension(
+                    &record, baseName, extension) ==
+                Storage::Record::ErrorStatus::None);
+  }
+  quiz_assert(fileSystem->recordBaseNamedWithExtension("r0010", extension)
+                  .isNull());
+  quiz_assert(fileSystem->numberOfRecordsStartingWithout('s', extension) ==
+              k_numberOfRecords - k_numberOfRecords / 10);
+  assert_small_records_are(extension, 0, 1, k_numberOfRecords);
+
+  // Grow the first records, which moves all the others
+  for (int i = 1; i < 10; i++) {
+    nameOfSmallRecord(baseName, 'r', i);
+    Storage::Record record =
+        fileSystem->recordBaseNamedWithExtension(baseName, extension);
+    char data[16] = {static_cast<char>(i)};
+    quiz_assert(record.setValue({.buffer = data, .size = sizeof(data)}) ==
+                Storage::Record::ErrorStatus::None);
+  }
+  assert_small_records_are(extension, 0, 1, k_numberOfRecords);
+
+  // Destroy the odd records
+  for (int i = 1; i < k_numberOfRecords; i += 2) {
+    nameOfSmallRecord(baseName, 'r', i);
+    fileSystem->recordBaseNamedWithExtension(baseName, extension).destroy();
+  }
+  assert_small_records_are(extension, 0, 2, k_numberOfRecords / 2);
+
+  /* Lookups remain right with more records than the index can hold, and
+   * once they are destroyed again. */
+  const char *otherExtension = "tiny";
+  constexpr int k_numberOfOtherRecords = 1500;
+  for (int i = 0; i < k_numberOfOtherRecords; i++) {
+    nameOfSmallRecord(baseName, 't', i);
+    quiz_assert(fileSystem->createRecordWithExtension(
+                    baseName, otherExtension, "", 0) ==
+                Storage::Record::ErrorStatus::None);
+  }
+  quiz_assert(fileSystem->numberOfRecordsWithExtension(otherExtension) ==
+              k_numberOfOtherRecords);
+  quiz_assert(!fileSystem->recordBaseNamedWithExtension("t1499", otherExtension)
+                   .isNull());
+  assert_small_records_are(extension, 0, 2, k_numberOfRecords / 2);
+  fileSystem->destroyRecordsWithExtension(otherExtension);
+  assert_small_records_are(extension, 0, 2, k_numberOfRecords / 2);
+
+  fileSystem->destroyRecordsWithExtension(extension);
+  quiz_assert(fileSystem->numberOfRecordsWithExtension(extension) == 0);
+  quiz_assert(fileSystem->availableSize() == initialAvailableSize);
+}
@@ -25,6 +25,9 @@ class KDContext {
 
   // Line. Not anti-aliased.
   void drawLine(KDPoint p1, KDPoint p2, KDColor c);
+  /* Join consecutive points with lines. Like with drawLine, the last point is
+   * not drawn. */
+  void drawPolyline(const KDPoint* points, int numberOfPoints, KDColor c);
   void drawAntialiasedLine(KDPoint p1, KDPoint p2, KDColor c,
                            KDColor background) {
     drawAntialiasedLine(p1.x(), p1.y(), p2.x(), p2.y(), c, background);
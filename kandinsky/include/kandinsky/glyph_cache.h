@@ -0,0 +1,72 @@
+#ifndef KANDINSKY_GLYPH_CACHE_H
+#define KANDINSKY_GLYPH_CACHE_H
+
+#include <kandinsky/font.h>
+#include <stdint.h>
+
+#if KANDINSKY_GLYPH_CACHE_SIZE
+
+/* KDGlyphCache keeps the decompressed grayscales of the most recently drawn
+ * glyphs, so that KDFont does not decompress the same few glyphs each time a
+ * string is drawn. Its memory budget is KANDINSKY_GLYPH_CACHE_SIZE bytes.
+ *
+ * Glyphs are found in constant time through a table indexed by font size and
+ * glyph index. Entries are chained from the most to the least recently used,
+ * the last one is replaced when the cache is full. Entry indices are offset by
+ * one so that a zero-initialized cache is empty. */
+
+class KDGlyphCache final {
+ public:
+  constexpr static int k_glyphDataSize =
+      KDFont::k_maxGlyphPixelCount * k_grayscaleBitsPerPixel / 8;
+
+  static KDGlyphCache* SharedCache();
+
+  // Return the cached grayscales of a glyph, or nullptr
+  const uint8_t* glyph(KDFont::Size size, KDFont::GlyphIndex index);
+  /* Reserve an entry for a glyph and return the buffer where its grayscales
+   * should be decompressed. */
+  uint8_t* storeGlyph(KDFont::Size size, KDFont::GlyphIndex index);
+  void reset();
+
+  int numberOfHits() const { return m_numberOfHits; }
+  int numberOfMisses() const { return m_numberOfMisses; }
+
+ private:
+  constexpr static int k_glyphIndexBits = 8 * sizeof(KDFont::GlyphIndex);
+  // One key per glyph index of each font size
+  constexpr static int k_numberOfKeys = 2 << k_glyphIndexBits;
+
+  struct Entry {
+    uint8_t data[k_glyphDataSize];
+    uint16_t key;
+    uint16_t previous;
+    uint16_t next;
+  };
+
+ public:
+  constexpr static int k_numberOfEntries =
+      KANDINSKY_GLYPH_CACHE_SIZE / sizeof(Entry);
+  static_assert(k_numberOfEntries > 0 && k_numberOfEntries < UINT16_MAX,
+                "KANDINSKY_GLYPH_CACHE_SIZE cannot hold a glyph");
+
+ private:
+  static uint16_t Key(KDFont::Size size, KDFont::GlyphIndex index) {
+    return static_cast<uint16_t>(size) << k_glyphIndexBits | index;
+  }
+  Entry* entry(uint16_t entryIndex) { return &m_entries[entryIndex - 1]; }
+  void unlink(uint16_t entryIndex);
+  void pushFront(uint16_t entryIndex);
+
+  Entry m_entries[k_numberOfEntries];
+  uint16_t m_entryForKey[k_numberOfKeys];
+  uint16_t m_mostRecentlyUsed;
+  uint16_t m_leastRecentlyUsed;
+  uint16_t m_numberOfUsedEntries;
+  int m_numberOfHits;
+  int m_numberOfMisses;
+};
+
+#endif
+
+#endif
@@ -12,11 +12,28 @@ class KDIonContext : public KDContext {
   static void Putchar(char c);
   static void Clear(KDPoint newCursorPosition = KDPointZero);
 
+#if KANDINSKY_DISPLAY_TELEMETRY
+  struct Telemetry {
+    // Calls to pushRect and pushRectUniform since the context was built
+    int numberOfPushedRects;
+    int64_t numberOfPushedPixels;
+  };
+  const Telemetry& telemetry() const { return m_telemetry; }
+#endif
+
  private:
   KDIonContext();
   void pushRect(KDRect rect, const KDColor* pixels) override;
   void pushRectUniform(KDRect rect, KDColor color) override;
   void pullRect(KDRect rect, KDColor* pixels) override;
+#if KANDINSKY_DISPLAY_TELEMETRY
+  void didPushRect(KDRect rect) {
+    m_telemetry.numberOfPushedRects++;
+    m_telemetry.numberOfPushedPixels += rect.width() * rect.height();
+  }
+
+  Telemetry m_telemetry;
+#endif
 };
 
 #endif
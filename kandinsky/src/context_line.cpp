@@ -6,60 +6,69 @@
 #include <cmath>
 
 void KDContext::drawLine(KDPoint p1, KDPoint p2, KDColor c) {
-  // Find the largest gap
-  KDPoint left = KDPointZero, right = KDPointZero;
-  if (p2.x() > p1.x()) {
-    left = p1;
-    right = p2;
-  } else {
-    left = p2;
-    right = p1;
+  /* Bresenham's algorithm, drawn by runs of pixels sharing the same minor
+   * coordinate. Along the major axis, from the start point, the k-th pixel is
+   * offset by floor((k * 2 * minorLength + majorLength) / (2 * majorLength))
+   * on the minor axis. The segment is first clipped on the major axis, then
+   * each run is clipped and pushed at once. As in Bresenham's algorithm, the
+   * last point of the segment is not drawn. */
+  int x1 = p1.x() + m_origin.x();
+  int y1 = p1.y() + m_origin.y();
+  int x2 = p2.x() + m_origin.x();
+  int y2 = p2.y() + m_origin.y();
+  bool horizontalMajor = std::abs(x2 - x1) >= std::abs(y2 - y1);
+  if (!horizontalMajor) {
+    std::swap(x1, y1);
+    std::swap(x2, y2);
   }
-  KDPoint top = KDPointZero, bottom = KDPointZero;
-  if (p2.y() > p1.y()) {
-    top = p1;
-    bottom = p2;
-  } else {
-    top = p2;
-    bottom = p1;
+  // From now on, x is the major axis and y the minor axis
+  if (x2 < x1) {
+    std::swap(x1, x2);
+    std::swap(y1, y2);
   }
-  assert(right.x() >= left.x());
-  assert(bottom.y() >= top.y());
-
-  KDCoordinate deltaX = 2 * (right.x() - left.x());
-  KDCoordinate deltaY = 2 * (bottom.y() - top.y());
-
-  KDPoint p = KDPointZero, alwaysTranslate = KDPointZero,
-          conditionalTranslate = KDPointZero;
-  KDCoordinate scanLength, error, minusError, plusError;
+  int majorLength = x2 - x1;
+  int minorLength = std::abs(y2 - y1);
+  int minorDirection = y2 >= y1 ? 1 : -1;
+  int majorClipMin = horizontalMajor ? m_clippingRect.left()
+                                     : m_clippingRect.top();
+  int majorClipMax = horizontalMajor ? m_clippingRect.right()
+                                     : m_clippingRect.bottom();
+  int minorClipMin = horizontalMajor ? m_clippingRect.top()
+                                     : m_clippingRect.left();
+  int minorClipMax = horizontalMajor ? m_clippingRect.bottom()
+                                     : m_clippingRect.right();
 
-  if (deltaX >= deltaY) {
-    p = left;
-    scanLength = right.x() - left.x();
-    error = right.x() - left.x();
-    minusError = deltaY;
-    plusError = deltaX;
-    alwaysTranslate = KDPoint(1, 0);
-    conditionalTranslate = KDPoint(0, (right.y() >= left.y() ? 1 : -1));
-  } else {
-    p = top;
-    scanLength = bottom.y() - top.y();
-    error = bottom.y() - top.y();
-    minusError = deltaX;
-    plusError = deltaY;
-    alwaysTranslate = KDPoint(0, 1);
-    conditionalTranslate = KDPoint((bottom.x() >= top.x() ? 1 : -1), 0);
+  int kMin = std::max(0, majorClipMin - x1);
+  int kMax = std::min(majorLength - 1, majorClipMax - x1);
+  int64_t doubleMajorLength = 2 * static_cast<int64_t>(majorLength);
+  int64_t doubleMinorLength = 2 * static_cast<int64_t>(minorLength);
+  int k = kMin;
+  while (k <= kMax) {
+    int64_t minorOffset = (k * doubleMinorLength + majorLength) /
+                          doubleMajorLength;
+    int runEnd = kMax;
+    if (minorLength > 0) {
+      // First k reaching the next minor offset
+      int64_t nextK = ((minorOffset + 1) * doubleMajorLength - majorLength +
+                       doubleMinorLength - 1) /
+                      doubleMinorLength;
+      runEnd = std::min<int64_t>(nextK - 1, kMax);
+    }
+    int64_t y = y1 + minorDirection * minorOffset;
+    if (minorClipMin <= y && y <= minorClipMax) {
+      KDCoordinate runLength = runEnd - k + 1;
+      pushRectUniform(horizontalMajor ? KDRect(x1 + k, y, runLength, 1)
+                                      : KDRect(y, x1 + k, 1, runLength),
+                      c);
+    }
+    k = runEnd + 1;
   }
+}
 
-  KDCoordinate scanCounter = 0;
-  while (scanCounter++ < scanLength) {
-    setPixel(p, c);
-    p = p.translatedBy(alwaysTranslate);
-    error = error - minusError;
-    if (error <= 0) {
-      p = p.translatedBy(conditionalTranslate);
-      error = error + plusError;
-    }
+void KDContext::drawPolyline(const KDPoint* points, int numberOfPoints,
+                             KDColor c) {
+  for (int i = 1; i < numberOfPoints; i++) {
+    drawLine(points[i - 1], points[i], c);
   }
 }
 
@@ -85,17 +94,13 @@ void KDContext::drawAntialiasedLine(float x1, float y1, float x2, float y2,
   for (int x = x1; x <= x2; x++) {
     double y = y1 + gradient * (x - x1);
     int yBelow = std::floor(y);
-    int yAbove = yBelow + 1;
     float fractionalPart = y - yBelow;
     uint8_t alpha = 255u * (1 - fractionalPart);
-    KDColor colorBelow = KDColor::Blend(c, background, alpha);
-    KDColor colorAbove = KDColor::Blend(c, background, 255 - alpha);
-    if (steep) {
-      setPixel(KDPoint(yBelow, x), colorBelow);
-      setPixel(KDPoint(yAbove, x), colorAbove);
-    } else {
-      setPixel(KDPoint(x, yBelow), colorBelow);
-      setPixel(KDPoint(x, yAbove), colorAbove);
-    }
+    // Push both pixels at once
+    KDColor colors[2] = {KDColor::Blend(c, background, alpha),
+                         KDColor::Blend(c, background, 255 - alpha)};
+    fillRectWithPixels(
+        steep ? KDRect(yBelow, x, 2, 1) : KDRect(x, yBelow, 1, 2), colors,
+        colors);
   }
 }
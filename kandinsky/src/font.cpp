@@ -5,6 +5,8 @@ extern "C" {
 #include <assert.h>
 #include <ion.h>
 #include <ion/unicode/utf8_decoder.h>
+#include <kandinsky/glyph_cache.h>
+#include <string.h>
 
 #include <algorithm>
 
@@ -66,10 +68,25 @@ void KDFont::accumulateGlyphGrayscalesForCodePoint(
 
 void KDFont::fetchGrayscaleGlyphAtIndex(KDFont::GlyphIndex index,
                                         uint8_t* grayscaleBuffer) const {
-  Ion::decompress(
-      compressedGlyphData(index), grayscaleBuffer,
-      compressedGlyphDataSize(index),
-      m_glyphSize.width() * m_glyphSize.height() * k_grayscaleBitsPerPixel / 8);
+  int grayscaleSize =
+      m_glyphSize.width() * m_glyphSize.height() * k_grayscaleBitsPerPixel / 8;
+#if KANDINSKY_GLYPH_CACHE_SIZE
+  if (this == &privateSmallFont || this == &privateLargeFont) {
+    Size size = this == &privateSmallFont ? Size::Small : Size::Large;
+    KDGlyphCache* cache = KDGlyphCache::SharedCache();
+    const uint8_t* cachedGrayscales = cache->glyph(size, index);
+    if (cachedGrayscales == nullptr) {
+      uint8_t* entryBuffer = cache->storeGlyph(size, index);
+      Ion::decompress(compressedGlyphData(index), entryBuffer,
+                      compressedGlyphDataSize(index), grayscaleSize);
+      cachedGrayscales = entryBuffer;
+    }
+    memcpy(grayscaleBuffer, cachedGrayscales, grayscaleSize);
+    return;
+  }
+#endif
+  Ion::decompress(compressedGlyphData(index), grayscaleBuffer,
+                  compressedGlyphDataSize(index), grayscaleSize);
 }
 
 void KDFont::colorizeGlyphBuffer(const RenderPalette* renderPalette,
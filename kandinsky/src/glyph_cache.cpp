@@ -0,0 +1,80 @@
+#include <assert.h>
+#include <kandinsky/glyph_cache.h>
+
+#if KANDINSKY_GLYPH_CACHE_SIZE
+
+static KDGlyphCache s_sharedCache;
+
+KDGlyphCache* KDGlyphCache::SharedCache() { return &s_sharedCache; }
+
+const uint8_t* KDGlyphCache::glyph(KDFont::Size size,
+                                   KDFont::GlyphIndex index) {
+  uint16_t entryIndex = m_entryForKey[Key(size, index)];
+  if (entryIndex == 0) {
+    m_numberOfMisses++;
+    return nullptr;
+  }
+  m_numberOfHits++;
+  if (entryIndex != m_mostRecentlyUsed) {
+    unlink(entryIndex);
+    pushFront(entryIndex);
+  }
+  return entry(entryIndex)->data;
+}
+
+uint8_t* KDGlyphCache::storeGlyph(KDFont::Size size,
+                                  KDFont::GlyphIndex index) {
+  uint16_t key = Key(size, index);
+  assert(m_entryForKey[key] == 0);
+  uint16_t entryIndex;
+  if (m_numberOfUsedEntries < k_numberOfEntries) {
+    entryIndex = ++m_numberOfUsedEntries;
+  } else {
+    entryIndex = m_leastRecentlyUsed;
+    unlink(entryIndex);
+    m_entryForKey[entry(entryIndex)->key] = 0;
+  }
+  entry(entryIndex)->key = key;
+  m_entryForKey[key] = entryIndex;
+  pushFront(entryIndex);
+  return entry(entryIndex)->data;
+}
+
+void KDGlyphCache::reset() {
+  for (uint16_t& entryIndex : m_entryForKey) {
+    entryIndex = 0;
+  }
+  m_mostRecentlyUsed = 0;
+  m_leastRecentlyUsed = 0;
+  m_numberOfUsedEntries = 0;
+  m_numberOfHits = 0;
+  m_numberOfMisses = 0;
+}
+
+void KDGlyphCache::unlink(uint16_t entryIndex) {
+  Entry* e = entry(entryIndex);
+  if (e->previous != 0) {
+    entry(e->previous)->next = e->next;
+  } else {
+    m_mostRecentlyUsed = e->next;
+  }
+  if (e->next != 0) {
+    entry(e->next)->previous = e->previous;
+  } else {
+    m_leastRecentlyUsed = e->previous;
+  }
+}
+
+void KDGlyphCache::pushFront(uint16_t entryIndex) {
+  Entry* e = entry(entryIndex);
+  e->previous = 0;
+  e->next = m_mostRecentlyUsed;
+  if (m_mostRecentlyUsed != 0) {
+    entry(m_mostRecentlyUsed)->previous = entryIndex;
+  } else {
+    m_leastRecentlyUsed = entryIndex;
+  }
+  m_mostRecentlyUsed = entryIndex;
+}
+
+#endif
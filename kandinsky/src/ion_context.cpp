@@ -3,13 +3,26 @@
 
 OMG::GlobalBox<KDIonContext> KDIonContext::SharedContext;
 
-KDIonContext::KDIonContext() : KDContext(KDPointZero, KDRectScreen) {}
+KDIonContext::KDIonContext()
+    : KDContext(KDPointZero, KDRectScreen)
+#if KANDINSKY_DISPLAY_TELEMETRY
+      ,
+      m_telemetry{0, 0}
+#endif
+{
+}
 
 void KDIonContext::pushRect(KDRect rect, const KDColor* pixels) {
+#if KANDINSKY_DISPLAY_TELEMETRY
+  didPushRect(rect);
+#endif
   Ion::Display::pushRect(rect, pixels);
 }
 
 void KDIonContext::pushRectUniform(KDRect rect, KDColor color) {
+#if KANDINSKY_DISPLAY_TELEMETRY
+  didPushRect(rect);
+#endif
   Ion::Display::pushRectUniform(rect, color);
 }
 
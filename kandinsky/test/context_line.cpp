@@ -0,0 +1,118 @@
+#include <assert.h>
+#include <kandinsky/context.h>
+#include <quiz.h>
+#include <stdlib.h>
+
+constexpr KDCoordinate k_size = 32;
+
+class TestContext : public KDContext {
+ public:
+  TestContext(KDPoint origin, KDRect clippingRect)
+      : KDContext(origin, clippingRect), m_numberOfPushes(0) {
+    for (KDColor& pixel : m_pixels) {
+      pixel = KDColorWhite;
+    }
+  }
+  KDColor pixel(int x, int y) const { return m_pixels[y * k_size + x]; }
+  int numberOfPushes() const { return m_numberOfPushes; }
+
+ private:
+  void pushRect(KDRect rect, const KDColor* pixels) override {
+    assert(KDRect(0, 0, k_size, k_size).containsRect(rect));
+    m_numberOfPushes++;
+    for (int y = 0; y < rect.height(); y++) {
+      for (int x = 0; x < rect.width(); x++) {
+        m_pixels[(rect.y() + y) * k_size + rect.x() + x] =
+            pixels[y * rect.width() + x];
+      }
+    }
+  }
+  void pushRectUniform(KDRect rect, KDColor color) override {
+    assert(KDRect(0, 0, k_size, k_size).containsRect(rect));
+    m_numberOfPushes++;
+    for (int y = 0; y < rect.height(); y++) {
+      for (int x = 0; x < rect.width(); x++) {
+        m_pixels[(rect.y() + y) * k_size + rect.x() + x] = color;
+      }
+    }
+  }
+  void pullRect(KDRect rect, KDColor* pixels) override {}
+
+  KDColor m_pixels[k_size * k_size];
+  int m_numberOfPushes;
+};
+
+// Bresenham's algorithm, drawn pixel by pixel
+static void drawReferenceLine(KDContext* ctx, KDPoint p1, KDPoint p2,
+                              KDColor c) {
+  int dx = abs(p2.x() - p1.x());
+  int dy = abs(p2.y() - p1.y());
+  bool horizontalMajor = dx >= dy;
+  KDPoint start = horizontalMajor ? (p1.x() < p2.x() ? p1 : p2)
+                                  : (p1.y() < p2.y() ? p1 : p2);
+  KDPoint end = start == p1 ? p2 : p1;
+  KDPoint majorStep = horizontalMajor ? KDPoint(1, 0) : KDPoint(0, 1);
+  KDPoint minorStep =
+      horizontalMajor ? KDPoint(0, end.y() >= start.y() ? 1 : -1)
+                      : KDPoint(end.x() >= start.x() ? 1 : -1, 0);
+  int length = horizontalMajor ? dx : dy;
+  int error = length;
+  KDPoint p = start;
+  for (int i = 0; i < length; i++) {
+    ctx->setPixel(p, c);
+    p = p.translatedBy(majorStep);
+    error -= 2 * (horizontalMajor ? dy : dx);
+    if (error <= 0) {
+      p = p.translatedBy(minorStep);
+      error += 2 * length;
+    }
+  }
+}
+
+static void assert_line_is_drawn_like_reference(KDPoint p1, KDPoint p2,
+                                                KDPoint origin,
+                                                KDRect clippingRect) {
+  TestContext context(origin, clippingRect);
+  TestContext reference(origin, clippingRect);
+  context.drawLine(p1, p2, KDColorBlack);
+  drawReferenceLine(&reference, p1, p2, KDColorBlack);
+  for (int y = 0; y < k_size; y++) {
+    for (int x = 0; x < k_size; x++) {
+      quiz_assert(context.pixel(x, y) == reference.pixel(x, y));
+    }
+  }
+}
+
+QUIZ_CASE(kandinsky_context_draw_line) {
+  KDRect screen(0, 0, k_size, k_size);
+  // Runs are pushed at once
+  TestContext context(KDPointZero, screen);
+  context.drawLine(KDPoint(1, 1), KDPoint(21, 3), KDColorBlack);
+  quiz_assert(context.numberOfPushes() == 3);
+  context.drawLine(KDPoint(5, 30), KDPoint(5, 2), KDColorBlack);
+  quiz_assert(context.numberOfPushes() == 4);
+
+  // A polyline is drawn as its successive segments
+  KDPoint points[] = {KDPoint(2, 3), KDPoint(20, 9), KDPoint(12, 28)};
+  TestContext polyline(KDPointZero, screen);
+  TestContext lines(KDPointZero, screen);
+  polyline.drawPolyline(points, 3, KDColorBlack);
+  lines.drawLine(points[0], points[1], KDColorBlack);
+  lines.drawLine(points[1], points[2], KDColorBlack);
+  for (int y = 0; y < k_size; y++) {
+    for (int x = 0; x < k_size; x++) {
+      quiz_assert(polyline.pixel(x, y) == lines.pixel(x, y));
+    }
+  }
+
+  srand(42);
+  for (int i = 0; i < 2000; i++) {
+    KDPoint p1(rand() % 64 - 16, rand() % 64 - 16);
+    KDPoint p2(rand() % 64 - 16, rand() % 64 - 16);
+    KDPoint origin(rand() % 9 - 4, rand() % 9 - 4);
+    KDRect clippingRect =
+        i % 2 == 0 ? screen
+                   : KDRect(rand() % 16, rand() % 16, rand() % 17, rand() % 17);
+    assert_line_is_drawn_like_reference(p1, p2, origin, clippingRect);
+  }
+}
@@ -1,7 +1,9 @@
 #include <assert.h>
 #include <kandinsky/font.h>
 #include <kandinsky/fonts/code_points.h>
+#include <kandinsky/glyph_cache.h>
 #include <quiz.h>
+#include <string.h>
 
 constexpr KDFont testFont(10, 10, nullptr, nullptr);
 
@@ -26,3 +28,48 @@ QUIZ_CASE(kandinsky_font_index_for_code_point) {
                  valueNotInArray(CodePoints, NumberOfCodePoints, codePoint)));
   }
 }
+
+QUIZ_CASE(kandinsky_font_glyph_cache) {
+#if KANDINSKY_GLYPH_CACHE_SIZE
+  KDGlyphCache* cache = KDGlyphCache::SharedCache();
+  cache->reset();
+  const KDFont* font = KDFont::Font(KDFont::Size::Large);
+  int pixelCount = KDFont::GlyphWidth(KDFont::Size::Large) *
+                   KDFont::GlyphHeight(KDFont::Size::Large);
+  KDFont::GlyphBuffer first;
+  KDFont::GlyphBuffer second;
+
+  font->setGlyphGrayscalesForCodePoint('a', &first);
+  quiz_assert(cache->numberOfMisses() == 1 && cache->numberOfHits() == 0);
+  font->setGlyphGrayscalesForCodePoint('a', &second);
+  quiz_assert(cache->numberOfMisses() == 1 && cache->numberOfHits() == 1);
+  quiz_assert(memcmp(first.grayscaleBuffer(), second.grayscaleBuffer(),
+                     pixelCount * k_grayscaleBitsPerPixel / 8) == 0);
+
+  // Glyphs of different sizes have their own entries
+  KDFont::Font(KDFont::Size::Small)
+      ->setGlyphGrayscalesForCodePoint('a', &second);
+  quiz_assert(cache->numberOfMisses() == 2);
+
+  /* The least recently used glyph is replaced when the cache is full, which
+   * only happens if the cache cannot hold all the glyphs. */
+  cache->reset();
+  font->setGlyphGrayscalesForCodePoint('a', &second);
+  int numberOfGlyphs = 1;
+  for (int i = 0; i < NumberOfCodePoints &&
+                  numberOfGlyphs <= KDGlyphCache::k_numberOfEntries;
+       i++) {
+    KDFont::Font(KDFont::Size::Small)
+        ->setGlyphGrayscalesForCodePoint(CodePoints[i], &second);
+    numberOfGlyphs++;
+  }
+  int numberOfMisses = cache->numberOfMisses();
+  font->setGlyphGrayscalesForCodePoint('a', &second);
+  quiz_assert(cache->numberOfMisses() ==
+              numberOfMisses +
+                  (numberOfGlyphs > KDGlyphCache::k_numberOfEntries));
+  quiz_assert(memcmp(first.grayscaleBuffer(), second.grayscaleBuffer(),
+                     pixelCount * k_grayscaleBitsPerPixel / 8) == 0);
+  cache->reset();
+#endif
+}
@@ -10,6 +10,7 @@ namespace Poincare {
 
 class ArcCosineNode final : public ExpressionNode {
   friend class ArcSecantNode;
+  friend class CompiledApproximation;
 
  public:
   constexpr static AliasesList k_functionName = AliasesLists::k_acosAliases;
@@ -10,6 +10,7 @@ namespace Poincare {
 
 class ArcSineNode final : public ExpressionNode {
   friend class ArcCosecantNode;
+  friend class CompiledApproximation;
 
  public:
   constexpr static AliasesList k_functionName = AliasesLists::k_asinAliases;
@@ -10,6 +10,7 @@ namespace Poincare {
 
 class ArcTangentNode final : public ExpressionNode {
   friend class ArcCotangentNode;
+  friend class CompiledApproximation;
 
  public:
   constexpr static AliasesList k_functionName = AliasesLists::k_atanAliases;
@@ -7,6 +7,8 @@
 namespace Poincare {
 
 class CeilingNode final : public ExpressionNode {
+  friend class CompiledApproximation;
+
  public:
   constexpr static AliasesList k_functionName = "ceil";
 
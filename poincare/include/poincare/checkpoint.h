@@ -22,6 +22,8 @@ void interruptableCode() {
 
 #define CheckpointRun(checkpoint, activation) (checkpoint.setActive(activation))
 
+#include <poincare/thread_local.h>
+
 namespace Poincare {
 
 class TreeNode;
@@ -44,7 +46,7 @@ class Checkpoint {
   virtual void discard() const { protectedDiscard(); }
 
  protected:
-  static Checkpoint *s_topmost;
+  static POINCARE_THREAD_LOCAL Checkpoint *s_topmost;
 
   void rollback() const;
   void protectedDiscard() const;
@@ -0,0 +1,151 @@
+#ifndef POINCARE_COMPILED_APPROXIMATION_H
+#define POINCARE_COMPILED_APPROXIMATION_H
+
+#include <poincare/approximation_helper.h>
+#include <poincare/computation_context.h>
+#include <poincare/expression.h>
+#include <stdint.h>
+
+#include <complex>
+
+namespace Poincare {
+
+/* CompiledApproximation lowers a reduced expression depending on one symbol
+ * into a flat register-based program, so that it can be approximated many
+ * times in a row (graph plotting, zoom, solver) without walking the TreePool
+ * and building Evaluation nodes at each step.
+ *
+ * Each instruction calls the same computeOnComplex functions as the tree
+ * evaluator, so that results are identical. Registers hold std::complex<T>
+ * because intermediate values of a real function can be complex (for instance
+ * sqrt(x)^2 with x<0).
+ *
+ * Subtrees that do not depend on any symbol are approximated once at compile
+ * time in both precisions. Only the node types listed in compileNode can be
+ * lowered: if the expression contains anything else (integrals, lists,
+ * randoms, other symbols...), the compilation fails and callers are expected
+ * to fall back on Expression::approximateToScalarWithValueForSymbol. */
+
+class CompiledApproximation {
+ public:
+  CompiledApproximation() { reset(); }
+
+  void compile(const Expression e, const char* symbol,
+               const ApproximationContext& approximationContext);
+  void reset();
+
+  bool isUninitialized() const { return m_status == Status::Uninitialized; }
+  bool isCompiled() const { return m_status == Status::Compiled; }
+  // Tell if the program was compiled with these complex format and angle unit
+  bool isValidFor(const ApproximationContext& approximationContext) const {
+    return !isUninitialized() &&
+           m_complexFormat == approximationContext.complexFormat() &&
+           m_angleUnit == approximationContext.angleUnit();
+  }
+  int numberOfInstructions() const { return m_numberOfInstructions; }
+
+  template <typename T>
+  T approximateToScalar(T x) const;
+  /* Approximate the program for numberOfValues values of the symbol at once.
+   * Values are run by batches of k_batchSize: each instruction is decoded and
+   * its compute function looked up once per batch, then called on each value
+   * of the batch. These are the scalar compute functions of the tree
+   * evaluator, there is no vectorized kernel. */
+  template <typename T>
+  void approximateToScalars(const T* x, T* results, int numberOfValues) const;
+
+ private:
+  constexpr static int k_batchSize = 8;
+  constexpr static int k_maxNumberOfInstructions = 32;
+  constexpr static int k_maxNumberOfConstants = 8;
+  constexpr static int k_maxNumberOfRegisters = 8;
+
+  enum class Status : uint8_t { Uninitialized, Compiled, Failed };
+
+  enum class OpCode : uint8_t {
+    LoadConstant,
+    LoadSymbol,
+    // Binary operations, reduced as in ApproximationHelper::MapReduce
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    // Binary operations with specific undefined handling
+    Power,
+    RationalPower,
+    Guard,
+    // Binary operation, mapped as in LogarithmNode::templatedApproximate
+    BasedLogarithm,
+    // Unary operations, mapped as in ApproximationHelper::MapOneChild
+    Opposite,
+    AbsoluteValue,
+    SquareRoot,
+    NaperianLogarithm,
+    Logarithm,
+    SignFunction,
+    Sine,
+    Cosine,
+    Tangent,
+    ArcSine,
+    ArcCosine,
+    ArcTangent,
+    HyperbolicSine,
+    HyperbolicCosine,
+    HyperbolicTangent,
+    Floor,
+    Ceiling,
+  };
+
+  struct Instruction {
+    OpCode opCode;
+    // Register receiving the result, also the first operand
+    uint8_t destination;
+    // Second operand register
+    uint8_t operand;
+    // Index of the constant used by LoadConstant and RationalPower
+    uint8_t constant;
+  };
+
+  bool compileNode(const Expression e, int destination, const char* symbol,
+                   const ApproximationContext& approximationContext);
+  bool compileChildren(const Expression e, OpCode opCode, int destination,
+                       const char* symbol,
+                       const ApproximationContext& approximationContext);
+  bool pushInstruction(OpCode opCode, int destination, int operand = 0,
+                       int constant = 0);
+  bool pushConstant(std::complex<float> floatConstant,
+                    std::complex<double> doubleConstant, int* index);
+  template <typename T>
+  std::complex<T> constantAtIndex(int index) const;
+  template <typename T>
+  void execute(const T* x, T* results, int numberOfValues,
+               std::complex<T>* registers) const;
+  template <typename T>
+  static bool IsUndefined(std::complex<T> c) {
+    return std::isnan(c.real()) || std::isnan(c.imag());
+  }
+  template <typename T>
+  static std::complex<T> Box(std::complex<T> c, bool* encounteredComplex);
+  template <typename T>
+  static std::complex<T> ComputeOpposite(
+      const std::complex<T> c, Preferences::ComplexFormat complexFormat,
+      Preferences::AngleUnit angleUnit);
+  template <typename T>
+  static ApproximationHelper::ComplexAndComplexReduction<T> BinaryCompute(
+      OpCode opCode);
+  template <typename T>
+  static ApproximationHelper::ComplexCompute<T> UnaryCompute(OpCode opCode);
+
+  Instruction m_instructions[k_maxNumberOfInstructions];
+  std::complex<float> m_floatConstants[k_maxNumberOfConstants];
+  std::complex<double> m_doubleConstants[k_maxNumberOfConstants];
+  uint8_t m_numberOfInstructions;
+  uint8_t m_numberOfConstants;
+  Status m_status;
+  Preferences::ComplexFormat m_complexFormat;
+  Preferences::AngleUnit m_angleUnit;
+};
+
+}  // namespace Poincare
+
+#endif
@@ -32,6 +32,10 @@ class Context {
                                               const SymbolAbstract& symbol) = 0;
   virtual void tidyDownstreamPoolFrom(TreeNode* treePoolCursor = nullptr) {}
   virtual bool canRemoveUnderscoreToUnits() const { return true; }
+  /* Return a value that changes whenever the definitions of the symbols
+   * change, or 0 if the context cannot tell. Reductions are only memoized in
+   * contexts that have a version. */
+  virtual uint32_t versionForReductionCache() { return 0; }
 
  protected:
   /* This is used by the ContextWithParent to pass itself to its parent.
@@ -9,6 +9,7 @@ namespace Poincare {
 class Division;
 
 class DivisionNode final : public ExpressionNode {
+  friend class CompiledApproximation;
   friend class LogarithmNode;
 
  public:
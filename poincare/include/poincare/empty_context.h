@@ -19,6 +19,8 @@ class EmptyContext : public Context {
     assert(false);
     return false;
   }
+  // No symbol is ever defined
+  uint32_t versionForReductionCache() override { return 1; }
 
  protected:
   const Expression protectedExpressionForSymbolAbstract(
@@ -31,6 +31,7 @@ class Expression : public TreeHandle {
   friend class BinomialCoefficient;
   friend class Ceiling;
   friend class Comparison;
+  friend class CompiledApproximation;
   friend class ComplexArgument;
   friend class ComplexCartesian;
   friend class ComplexHelper;
@@ -756,6 +757,10 @@ class Expression : public TreeHandle {
    * representation but some smaller integers can't - like 2E308-1). */
   constexpr static double k_largestExactIEEE754Integer = 9007199254740992.0;
   Expression deepReduce(ReductionContext reductionContext);
+  // Reduction of cloneAndDeepReduceWithSystemCheckpoint, without memoization
+  Expression cloneAndDeepReduceWithSystemCheckpointWithoutCache(
+      ReductionContext* reductionContext, bool* reduceFailure,
+      bool approximateDuringReduction) const;
   void deepReduceChildren(const ReductionContext& reductionContext) {
     node()->deepReduceChildren(reductionContext);
   }
@@ -151,6 +151,12 @@ class ExpressionNode : public TreeNode {
 
   /* Poor man's RTTI */
   virtual Type type() const = 0;
+#if POINCARE_POOL_TELEMETRY
+  int telemetryType() const override { return static_cast<int>(type()); }
+  static_assert(static_cast<int>(Type::EmptyExpression) <
+                    TreePool::Telemetry::k_numberOfTypes,
+                "TreePool::Telemetry cannot count all expression types");
+#endif
 
   /* Properties */
   virtual TrinaryBoolean isPositive(Context* context) const {
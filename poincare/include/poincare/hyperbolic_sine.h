@@ -7,6 +7,8 @@
 namespace Poincare {
 
 class HyperbolicSineNode final : public HyperbolicTrigonometricFunctionNode {
+  friend class CompiledApproximation;
+
  public:
   constexpr static AliasesList k_functionName = "sinh";
 
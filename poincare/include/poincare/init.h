@@ -4,6 +4,8 @@
 namespace Poincare {
 
 void Init();
+// Undo Init, so that it can be called again
+void Shutdown();
 
 }
 
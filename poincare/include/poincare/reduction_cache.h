@@ -0,0 +1,91 @@
+#ifndef POINCARE_REDUCTION_CACHE_H
+#define POINCARE_REDUCTION_CACHE_H
+
+#include <poincare/computation_context.h>
+#include <poincare/expression.h>
+#include <poincare/thread_local.h>
+#include <poincare/tree_node.h>
+#include <stdint.h>
+
+namespace Poincare {
+
+/* ReductionCache memoizes the results of
+ * Expression::cloneAndDeepReduceWithSystemCheckpoint. Apps reduce the same few
+ * expressions over and over (a function is reduced again each time its record
+ * is reloaded), so the reduced trees are kept in a buffer outside of the
+ * TreePool, which survives the pool being emptied between apps.
+ *
+ * An entry is keyed by the bytes of the input tree, with the identifiers and
+ * reference counters of its nodes erased, along with the parameters of the
+ * reduction context, the shared Preferences and the version of the symbols
+ * definitions given by Context::versionForReductionCache. Trees are compared
+ * byte per byte on lookup, hashes only speed up the search.
+ *
+ * Reductions are not memoized if the context cannot tell its version, if the
+ * expression contains a random node or if the trees do not fit in an entry.
+ * When the cache is full, the least recently used entry is replaced. */
+
+class ReductionCache final {
+ public:
+  constexpr static int k_numberOfEntries = 16;
+  constexpr static size_t k_entrySize = 1024;
+
+  struct Key {
+    uint32_t treeHash;
+    uint32_t parameters;
+    uint32_t preferencesHash;
+    uint32_t contextVersion;
+    uint16_t treeSize;
+  };
+
+  static ReductionCache* SharedCache();
+
+  /* Fill key with the identity of the reduction of e. Return false if the
+   * reduction cannot be memoized. */
+  bool computeKey(const Expression e, const ReductionContext& reductionContext,
+                  bool approximateDuringReduction, Key* key);
+  /* Return a copy in the pool of the tree memoized for key, or an
+   * uninitialized expression. */
+  Expression lookup(const Key& key, bool* encounteredUndistributedList);
+  void store(const Key& key, const Expression e, const Expression reduced,
+             bool encounteredUndistributedList);
+  void reset();
+
+  int numberOfHits() const { return m_numberOfHits; }
+  int numberOfMisses() const { return m_numberOfMisses; }
+
+ private:
+  constexpr static uint32_t k_noContextVersion = 0;
+
+  struct Entry {
+    bool isEmpty() const { return reducedSize == 0; }
+    AlignedNodeBuffer* reducedTree() {
+      return buffer + key.treeSize / sizeof(AlignedNodeBuffer);
+    }
+
+    Key key;
+    uint16_t reducedSize;
+    bool encounteredUndistributedList;
+    uint32_t lastUse;
+    AlignedNodeBuffer buffer[k_entrySize / sizeof(AlignedNodeBuffer)];
+  };
+
+  /* Copy the tree of e into buffer, erasing the identifiers of its nodes.
+   * Return the size of the tree or 0 if it does not fit. */
+  static size_t CopyTree(const Expression e, AlignedNodeBuffer* buffer,
+                         size_t bufferSize);
+  static uint32_t Hash(const void* data, size_t size);
+  static bool KeysAreEqual(const Key& key1, const Key& key2);
+
+  // Every member is zero-initialized, which makes all the entries empty.
+  Entry m_entries[k_numberOfEntries];
+  // Normalized input tree of the last computed key
+  AlignedNodeBuffer m_scratch[k_entrySize / sizeof(AlignedNodeBuffer)];
+  uint32_t m_clock;
+  int m_numberOfHits;
+  int m_numberOfMisses;
+};
+
+}  // namespace Poincare
+
+#endif
@@ -2,6 +2,7 @@
 #define POINCARE_SOLVER_H
 
 #include <math.h>
+#include <poincare/compiled_approximation.h>
 #include <poincare/expression.h>
 #include <poincare/float.h>
 
@@ -121,6 +122,8 @@ class Solver {
     const ApproximationContext &approximationContext;
     const char *unknown;
     Expression expression;
+    // Flat program evaluating expression, if it could be compiled
+    const CompiledApproximation &compiledExpression;
   };
 
   constexpr static T k_NAN = static_cast<T>(NAN);
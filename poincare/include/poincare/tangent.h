@@ -7,6 +7,8 @@
 namespace Poincare {
 
 class TangentNode final : public ExpressionNode {
+  friend class CompiledApproximation;
+
  public:
   constexpr static AliasesList k_functionName = "tan";
 
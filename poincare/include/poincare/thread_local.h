@@ -0,0 +1,16 @@
+#ifndef POINCARE_THREAD_LOCAL_H
+#define POINCARE_THREAD_LOCAL_H
+
+/* Storage class of the global state of Poincare computations (the TreePool,
+ * the Checkpoint stack and a few working buffers). On the simulator, it can be
+ * made thread-local so that several threads run independent computations at
+ * the same time, each of them on its own pool. A thread must then initialize
+ * its TreePool::sharedPool before building any expression or layout. */
+
+#if POINCARE_THREAD_LOCAL_POOL
+#define POINCARE_THREAD_LOCAL thread_local
+#else
+#define POINCARE_THREAD_LOCAL
+#endif
+
+#endif
@@ -62,6 +62,11 @@ class TreeNode {
   virtual bool isGhost() const { return false; }
   bool deepIsGhost() const;
 
+#if POINCARE_POOL_TELEMETRY
+  // ExpressionNode::Type of the node, or -1 if it is not an expression
+  virtual int telemetryType() const { return -1; }
+#endif
+
   // Node operations
   void setReferenceCounter(int refCount) { m_referenceCounter = refCount; }
   /* Do not increase reference counters outside of the current checkpoint since
@@ -83,6 +88,13 @@ class TreeNode {
   void release(int currentNumberOfChildren);
   void rename(uint16_t identifier, bool unregisterPreviousIdentifier,
               bool skipChildrenUpdate = false);
+  /* Used on copies of nodes made outside of the pool, so that identical trees
+   * have identical copies. */
+  void eraseIdentifiers() {
+    m_identifier = NoNodeIdentifier;
+    m_parentIdentifier = NoNodeIdentifier;
+    m_referenceCounter = 0;
+  }
 
   // Checkpoint
   bool isAfterTopmostCheckpoint() const {
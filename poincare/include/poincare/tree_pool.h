@@ -2,6 +2,7 @@
 #define POINCARE_TREE_POOL_H
 
 #include <poincare/ghost_node.h>
+#include <poincare/thread_local.h>
 #include <stddef.h>
 #include <string.h>
 
@@ -22,7 +23,7 @@ class TreePool final {
   friend class Checkpoint;
 
  public:
-  static OMG::GlobalBox<TreePool> sharedPool
+  static POINCARE_THREAD_LOCAL OMG::GlobalBox<TreePool> sharedPool
 #if PLATFORM_DEVICE
       __attribute__((section(".bss.$poincare_pool")))
 #endif
@@ -38,7 +39,11 @@ class TreePool final {
 #endif
   }
 
-  TreePool() : m_cursor(buffer()) {}
+  TreePool() : m_cursor(buffer()) {
+#if POINCARE_POOL_TELEMETRY
+    resetTelemetry();
+#endif
+  }
 
   TreeNode *cursor() const { return reinterpret_cast<TreeNode *>(m_cursor); }
 
@@ -73,8 +78,33 @@ class TreePool final {
 #endif
   int numberOfNodes() const;
 
+#if POINCARE_POOL_TELEMETRY
+  struct Telemetry {
+    constexpr static int k_numberOfTypes = 128;
+    // Highest number of bytes used by the pool since the last reset
+    size_t peakSize;
+    // Number of ExceptionCheckpoint raised since the last reset
+    int numberOfRaises;
+    /* Number of nodes built or copied since the last reset, by
+     * ExpressionNode::Type. Other nodes (layouts, evaluations...) are counted
+     * together. Ghost children are not counted. */
+    int numberOfExpressions[k_numberOfTypes];
+    int numberOfOtherNodes;
+  };
+  const Telemetry &telemetry() const { return m_telemetry; }
+  void resetTelemetry();
+  void resetPeakSize() { m_telemetry.peakSize = m_cursor - constBuffer(); }
+  void didRaise() { m_telemetry.numberOfRaises++; }
+  void didBuildNode(const TreeNode *node);
+#endif
+  constexpr static int Size() { return BufferSize; }
+
  private:
-#ifdef SMALL_POINCARE_POOL
+#if POINCARE_POOL_SIZE
+  constexpr static int BufferSize = POINCARE_POOL_SIZE;
+  static_assert(BufferSize % ByteAlignment == 0,
+                "POINCARE_POOL_SIZE must be a multiple of ByteAlignment");
+#elif defined SMALL_POINCARE_POOL
   constexpr static int BufferSize = 32768;
 #else
   /* 32kb (previous size) + 8kb (newly available size)
@@ -84,7 +114,7 @@ class TreePool final {
   constexpr static int MaxNumberOfNodes = BufferSize / sizeof(TreeNode);
   constexpr static int k_maxNodeOffset = BufferSize / ByteAlignment;
 #if ASSERTIONS
-  static bool s_treePoolLocked;
+  static POINCARE_THREAD_LOCAL bool s_treePoolLocked;
 #endif
 
   // TreeNode
@@ -178,6 +208,9 @@ class TreePool final {
   char *m_cursor;
   IdentifierStack m_identifiers;
   uint16_t m_nodeForIdentifierOffset[MaxNumberOfNodes];
+#if POINCARE_POOL_TELEMETRY
+  Telemetry m_telemetry;
+#endif
   static_assert(k_maxNodeOffset < UINT16_MAX &&
                     sizeof(m_nodeForIdentifierOffset[0]) == sizeof(uint16_t),
                 "The tree pool node offsets in m_nodeForIdentifierOffset "
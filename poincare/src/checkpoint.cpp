@@ -5,7 +5,7 @@
 
 namespace Poincare {
 
-Checkpoint* Checkpoint::s_topmost = nullptr;
+POINCARE_THREAD_LOCAL Checkpoint* Checkpoint::s_topmost = nullptr;
 
 Checkpoint::Checkpoint()
     : m_parent(s_topmost), m_endOfPool(TreePool::sharedPool->last()) {
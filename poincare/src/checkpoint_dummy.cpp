@@ -3,7 +3,7 @@
 
 namespace Poincare {
 
-Checkpoint* Checkpoint::s_topmost = nullptr;
+POINCARE_THREAD_LOCAL Checkpoint* Checkpoint::s_topmost = nullptr;
 
 bool ExceptionCheckpoint::setActive(bool interruption) { return false; }
 
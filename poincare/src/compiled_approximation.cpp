@@ -0,0 +1,539 @@
+#include <poincare/absolute_value.h>
+#include <poincare/addition.h>
+#include <poincare/arc_cosine.h>
+#include <poincare/arc_sine.h>
+#include <poincare/arc_tangent.h>
+#include <poincare/ceiling.h>
+#include <poincare/compiled_approximation.h>
+#include <poincare/complex.h>
+#include <poincare/cosine.h>
+#include <poincare/division.h>
+#include <poincare/floor.h>
+#include <poincare/hyperbolic_cosine.h>
+#include <poincare/hyperbolic_sine.h>
+#include <poincare/hyperbolic_tangent.h>
+#include <poincare/logarithm.h>
+#include <poincare/multiplication.h>
+#include <poincare/naperian_logarithm.h>
+#include <poincare/power.h>
+#include <poincare/preferences.h>
+#include <poincare/rational.h>
+#include <poincare/sign_function.h>
+#include <poincare/sine.h>
+#include <poincare/square_root.h>
+#include <poincare/subtraction.h>
+#include <poincare/symbol.h>
+#include <poincare/tangent.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Poincare {
+
+void CompiledApproximation::reset() {
+  m_numberOfInstructions = 0;
+  m_numberOfConstants = 0;
+  m_status = Status::Uninitialized;
+  m_complexFormat = Preferences::ComplexFormat::Real;
+  m_angleUnit = Preferences::AngleUnit::Radian;
+}
+
+void CompiledApproximation::compile(
+    const Expression e, const char* symbol,
+    const ApproximationContext& approximationContext) {
+  reset();
+  m_complexFormat = approximationContext.complexFormat();
+  m_angleUnit = approximationContext.angleUnit();
+  /* Random nodes must be drawn at each approximation, they cannot be folded
+   * into constants. */
+  bool success = !e.isUninitialized() &&
+                 !e.recursivelyMatches(
+                     Expression::IsRandom, nullptr,
+                     SymbolicComputation::DoNotReplaceAnySymbol) &&
+                 compileNode(e, 0, symbol, approximationContext);
+  m_status = success ? Status::Compiled : Status::Failed;
+  if (!success) {
+    m_numberOfInstructions = 0;
+    m_numberOfConstants = 0;
+  }
+}
+
+template <typename T>
+T CompiledApproximation::approximateToScalar(T x) const {
+  std::complex<T> registers[k_maxNumberOfRegisters];
+  T result;
+  execute(&x, &result, 1, registers);
+  return result;
+}
+
+template <typename T>
+void CompiledApproximation::approximateToScalars(const T* x, T* results,
+                                                 int numberOfValues) const {
+  std::complex<T> registers[k_maxNumberOfRegisters * k_batchSize];
+  for (int i = 0; i < numberOfValues; i += k_batchSize) {
+    execute(x + i, results + i, std::min(numberOfValues - i, k_batchSize),
+            registers);
+  }
+}
+
+template <typename T>
+void CompiledApproximation::execute(const T* x, T* results, int numberOfValues,
+                                    std::complex<T>* registers) const {
+  assert(isCompiled());
+  assert(0 < numberOfValues && numberOfValues <= k_batchSize);
+  /* Replicates Expression::approximateToEvaluation, which flags every complex
+   * value built during the approximation. */
+  bool encounteredComplex[k_batchSize] = {};
+  for (int i = 0; i < m_numberOfInstructions; i++) {
+    const Instruction& instruction = m_instructions[i];
+    // Register r of value v is registers[r * numberOfValues + v]
+    std::complex<T>* result =
+        registers + instruction.destination * numberOfValues;
+    const std::complex<T>* operand =
+        registers + instruction.operand * numberOfValues;
+    switch (instruction.opCode) {
+      case OpCode::LoadConstant: {
+        std::complex<T> constant = constantAtIndex<T>(instruction.constant);
+        for (int v = 0; v < numberOfValues; v++) {
+          result[v] = Box(constant, encounteredComplex + v);
+        }
+        break;
+      }
+      case OpCode::LoadSymbol:
+        // Replicates FloatNode::templatedApproximate
+        for (int v = 0; v < numberOfValues; v++) {
+          result[v] = Box(std::complex<T>(x[v]), encounteredComplex + v);
+        }
+        break;
+      case OpCode::Add:
+      case OpCode::Subtract:
+      case OpCode::Multiply:
+      case OpCode::Divide: {
+        // Replicates ApproximationHelper::MapReduce
+        ApproximationHelper::ComplexAndComplexReduction<T> compute =
+            BinaryCompute<T>(instruction.opCode);
+        for (int v = 0; v < numberOfValues; v++) {
+          if (IsUndefined(result[v])) {
+            result[v] = complexNAN<T>();
+            continue;
+          }
+          result[v] = Box(compute(result[v], operand[v], m_complexFormat),
+                          encounteredComplex + v);
+          if (IsUndefined(result[v])) {
+            result[v] = complexNAN<T>();
+          }
+        }
+        break;
+      }
+      case OpCode::RationalPower:
+      case OpCode::Power: {
+        // Replicates PowerNode::templatedApproximate
+        bool hasRationalIndex = instruction.opCode == OpCode::RationalPower;
+        std::complex<T> pq =
+            hasRationalIndex ? constantAtIndex<T>(instruction.constant)
+                             : std::complex<T>();
+        for (int v = 0; v < numberOfValues; v++) {
+          if (hasRationalIndex) {
+            std::complex<T> root =
+                PowerNode::computeNotPrincipalRealRootOfRationalPow<T>(
+                    result[v], pq.real(), pq.imag());
+            if (!IsUndefined(root)) {
+              result[v] = Box(root, encounteredComplex + v);
+              continue;
+            }
+          }
+          result[v] = Box(PowerNode::computeOnComplex<T>(result[v], operand[v],
+                                                         m_complexFormat),
+                          encounteredComplex + v);
+          if (IsUndefined(result[v])) {
+            result[v] = complexNAN<T>();
+          }
+        }
+        break;
+      }
+      case OpCode::BasedLogarithm:
+        // Replicates LogarithmNode::templatedApproximate
+        for (int v = 0; v < numberOfValues; v++) {
+          result[v] = Box(DivisionNode::computeOnComplex<T>(
+                              LogarithmNode::computeOnComplex<T>(
+                                  result[v], m_complexFormat, m_angleUnit),
+                              LogarithmNode::computeOnComplex<T>(
+                                  operand[v], m_complexFormat, m_angleUnit),
+                              m_complexFormat),
+                          encounteredComplex + v);
+        }
+        break;
+      case OpCode::Guard:
+        // Replicates DependencyNode::templatedApproximate
+        for (int v = 0; v < numberOfValues; v++) {
+          if (IsUndefined(operand[v])) {
+            result[v] = complexNAN<T>();
+          }
+        }
+        break;
+      default: {
+        // Replicates ApproximationHelper::MapOneChild
+        ApproximationHelper::ComplexCompute<T> compute =
+            UnaryCompute<T>(instruction.opCode);
+        for (int v = 0; v < numberOfValues; v++) {
+          result[v] = Box(compute(result[v], m_complexFormat, m_angleUnit),
+                          encounteredComplex + v);
+        }
+      }
+    }
+  }
+  for (int v = 0; v < numberOfValues; v++) {
+    results[v] = m_complexFormat == Preferences::ComplexFormat::Real &&
+                         encounteredComplex[v]
+                     ? static_cast<T>(NAN)
+                     : ComplexNode<T>::ToScalar(registers[v]);
+  }
+}
+
+bool CompiledApproximation::compileNode(
+    const Expression e, int destination, const char* symbol,
+    const ApproximationContext& approximationContext) {
+  if (destination >= k_maxNumberOfRegisters) {
+    return false;
+  }
+  if (!e.recursivelyMatches(Expression::IsSymbolic, nullptr,
+                            SymbolicComputation::DoNotReplaceAnySymbol)) {
+    /* The subtree does not depend on the symbol: approximate it once. Complex
+     * values are kept, they are only discarded on the final result. In Real
+     * format, the tree also discards the result when an intermediate value
+     * was nonreal, which a folded constant cannot remember: such subtrees
+     * fall back on the tree evaluation. */
+    bool encounteredComplex = Expression::EncounteredComplex();
+    Expression::SetEncounteredComplex(false);
+    Evaluation<float> floatEvaluation =
+        e.node()->approximate(float(), approximationContext);
+    Evaluation<double> doubleEvaluation =
+        e.node()->approximate(double(), approximationContext);
+    bool foldedNonreal = m_complexFormat == Preferences::ComplexFormat::Real &&
+                         Expression::EncounteredComplex();
+    Expression::SetEncounteredComplex(encounteredComplex);
+    int index;
+    return !foldedNonreal &&
+           floatEvaluation.type() == EvaluationNode<float>::Type::Complex &&
+           doubleEvaluation.type() == EvaluationNode<double>::Type::Complex &&
+           pushConstant(floatEvaluation.complexAtIndex(0),
+                        doubleEvaluation.complexAtIndex(0), &index) &&
+           pushInstruction(OpCode::LoadConstant, destination, 0, index);
+  }
+  ExpressionNode::Type type = e.type();
+  switch (type) {
+    case ExpressionNode::Type::Symbol:
+      return strcmp(static_cast<const Symbol&>(e).name(), symbol) == 0 &&
+             pushInstruction(OpCode::LoadSymbol, destination);
+    case ExpressionNode::Type::Parenthesis:
+      return compileNode(e.childAtIndex(0), destination, symbol,
+                         approximationContext);
+    case ExpressionNode::Type::Addition:
+      return compileChildren(e, OpCode::Add, destination, symbol,
+                             approximationContext);
+    case ExpressionNode::Type::Subtraction:
+      return compileChildren(e, OpCode::Subtract, destination, symbol,
+                             approximationContext);
+    case ExpressionNode::Type::Multiplication:
+      return compileChildren(e, OpCode::Multiply, destination, symbol,
+                             approximationContext);
+    case ExpressionNode::Type::Division:
+      return compileChildren(e, OpCode::Divide, destination, symbol,
+                             approximationContext);
+    case ExpressionNode::Type::Power: {
+      if (!compileNode(e.childAtIndex(0), destination, symbol,
+                       approximationContext) ||
+          !compileNode(e.childAtIndex(1), destination + 1, symbol,
+                       approximationContext)) {
+        return false;
+      }
+      if (approximationContext.complexFormat() !=
+          Preferences::ComplexFormat::Real) {
+        return pushInstruction(OpCode::Power, destination, destination + 1);
+      }
+      /* Look for the rational index p/q that PowerNode::templatedApproximate
+       * uses to compute real roots which are not the principal root. */
+      Expression index = e.childAtIndex(1);
+      Integer p, q;
+      bool hasRationalIndex = false;
+      if (index.type() == ExpressionNode::Type::Rational) {
+        p = static_cast<const Rational&>(index).signedIntegerNumerator();
+        q = static_cast<const Rational&>(index).integerDenominator();
+        hasRationalIndex = true;
+      } else if (index.type() == ExpressionNode::Type::Division &&
+                 index.childAtIndex(0).type() ==
+                     ExpressionNode::Type::Rational &&
+                 index.childAtIndex(1).type() ==
+                     ExpressionNode::Type::Rational) {
+        Expression numerator = index.childAtIndex(0);
+        Expression denominator = index.childAtIndex(1);
+        const Rational& pRational = static_cast<const Rational&>(numerator);
+        const Rational& qRational = static_cast<const Rational&>(denominator);
+        if (pRational.integerDenominator().isOne() &&
+            qRational.integerDenominator().isOne()) {
+          p = pRational.signedIntegerNumerator();
+          q = qRational.signedIntegerNumerator();
+          hasRationalIndex = true;
+        }
+      }
+      if (!hasRationalIndex) {
+        return pushInstruction(OpCode::Power, destination, destination + 1);
+      }
+      int pqIndex;
+      return pushConstant(std::complex<float>(p.approximate<float>(),
+                                              q.approximate<float>()),
+                          std::complex<double>(p.approximate<double>(),
+                                               q.approximate<double>()),
+                          &pqIndex) &&
+             pushInstruction(OpCode::RationalPower, destination,
+                             destination + 1, pqIndex);
+    }
+    case ExpressionNode::Type::Dependency: {
+      Expression dependencies = e.childAtIndex(1);
+      if (dependencies.type() != ExpressionNode::Type::List ||
+          !compileNode(e.childAtIndex(0), destination, symbol,
+                       approximationContext)) {
+        return false;
+      }
+      int numberOfDependencies = dependencies.numberOfChildren();
+      for (int i = 0; i < numberOfDependencies; i++) {
+        if (!compileNode(dependencies.childAtIndex(i), destination + 1, symbol,
+                         approximationContext) ||
+            !pushInstruction(OpCode::Guard, destination, destination + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      break;
+  }
+
+  OpCode opCode;
+  switch (type) {
+    case ExpressionNode::Type::Opposite:
+      opCode = OpCode::Opposite;
+      break;
+    case ExpressionNode::Type::AbsoluteValue:
+      opCode = OpCode::AbsoluteValue;
+      break;
+    case ExpressionNode::Type::SquareRoot:
+      opCode = OpCode::SquareRoot;
+      break;
+    case ExpressionNode::Type::NaperianLogarithm:
+      opCode = OpCode::NaperianLogarithm;
+      break;
+    case ExpressionNode::Type::Logarithm:
+      if (e.numberOfChildren() == 2) {
+        /* The exam mode restriction on the base is checked at each
+         * approximation of the tree, keep it that way. */
+        return !Preferences::SharedPreferences()
+                    ->examMode()
+                    .forbidBasedLogarithm() &&
+               compileNode(e.childAtIndex(0), destination, symbol,
+                           approximationContext) &&
+               compileNode(e.childAtIndex(1), destination + 1, symbol,
+                           approximationContext) &&
+               pushInstruction(OpCode::BasedLogarithm, destination,
+                               destination + 1);
+      }
+      opCode = OpCode::Logarithm;
+      break;
+    case ExpressionNode::Type::SignFunction:
+      opCode = OpCode::SignFunction;
+      break;
+    case ExpressionNode::Type::Sine:
+      opCode = OpCode::Sine;
+      break;
+    case ExpressionNode::Type::Cosine:
+      opCode = OpCode::Cosine;
+      break;
+    case ExpressionNode::Type::Tangent:
+      opCode = OpCode::Tangent;
+      break;
+    case ExpressionNode::Type::ArcSine:
+      opCode = OpCode::ArcSine;
+      break;
+    case ExpressionNode::Type::ArcCosine:
+      opCode = OpCode::ArcCosine;
+      break;
+    case ExpressionNode::Type::ArcTangent:
+      opCode = OpCode::ArcTangent;
+      break;
+    case ExpressionNode::Type::HyperbolicSine:
+      opCode = OpCode::HyperbolicSine;
+      break;
+    case ExpressionNode::Type::HyperbolicCosine:
+      opCode = OpCode::HyperbolicCosine;
+      break;
+    case ExpressionNode::Type::HyperbolicTangent:
+      opCode = OpCode::HyperbolicTangent;
+      break;
+    case ExpressionNode::Type::Floor:
+      opCode = OpCode::Floor;
+      break;
+    case ExpressionNode::Type::Ceiling:
+      opCode = OpCode::Ceiling;
+      break;
+    default:
+      // This node cannot be lowered
+      return false;
+  }
+  assert(e.numberOfChildren() == 1);
+  return compileNode(e.childAtIndex(0), destination, symbol,
+                     approximationContext) &&
+         pushInstruction(opCode, destination);
+}
+
+bool CompiledApproximation::compileChildren(
+    const Expression e, OpCode opCode, int destination, const char* symbol,
+    const ApproximationContext& approximationContext) {
+  int numberOfChildren = e.numberOfChildren();
+  if (numberOfChildren < 2 || !compileNode(e.childAtIndex(0), destination,
+                                           symbol, approximationContext)) {
+    return false;
+  }
+  for (int i = 1; i < numberOfChildren; i++) {
+    if (!compileNode(e.childAtIndex(i), destination + 1, symbol,
+                     approximationContext) ||
+        !pushInstruction(opCode, destination, destination + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompiledApproximation::pushInstruction(OpCode opCode, int destination,
+                                            int operand, int constant) {
+  if (m_numberOfInstructions >= k_maxNumberOfInstructions) {
+    return false;
+  }
+  assert(destination < k_maxNumberOfRegisters &&
+         operand < k_maxNumberOfRegisters);
+  m_instructions[m_numberOfInstructions++] = {
+      .opCode = opCode,
+      .destination = static_cast<uint8_t>(destination),
+      .operand = static_cast<uint8_t>(operand),
+      .constant = static_cast<uint8_t>(constant)};
+  return true;
+}
+
+bool CompiledApproximation::pushConstant(std::complex<float> floatConstant,
+                                         std::complex<double> doubleConstant,
+                                         int* index) {
+  if (m_numberOfConstants >= k_maxNumberOfConstants) {
+    return false;
+  }
+  *index = m_numberOfConstants++;
+  m_floatConstants[*index] = floatConstant;
+  m_doubleConstants[*index] = doubleConstant;
+  return true;
+}
+
+template <>
+std::complex<float> CompiledApproximation::constantAtIndex<float>(
+    int index) const {
+  assert(index < m_numberOfConstants);
+  return m_floatConstants[index];
+}
+
+template <>
+std::complex<double> CompiledApproximation::constantAtIndex<double>(
+    int index) const {
+  assert(index < m_numberOfConstants);
+  return m_doubleConstants[index];
+}
+
+template <typename T>
+std::complex<T> CompiledApproximation::Box(std::complex<T> c,
+                                           bool* encounteredComplex) {
+  // Replicates the ComplexNode constructor
+  if (!std::isnan(c.imag()) && c.imag() != static_cast<T>(0.0)) {
+    *encounteredComplex = true;
+  }
+  if (c.real() == static_cast<T>(0.0)) {
+    c.real(0);
+  }
+  if (c.imag() == static_cast<T>(0.0)) {
+    c.imag(0);
+  }
+  return c;
+}
+
+template <typename T>
+std::complex<T> CompiledApproximation::ComputeOpposite(
+    const std::complex<T> c, Preferences::ComplexFormat complexFormat,
+    Preferences::AngleUnit angleUnit) {
+  // Replicates OppositeNode::templatedApproximate
+  return MultiplicationNode::computeOnComplex<T>(std::complex<T>(-1), c,
+                                                 complexFormat);
+}
+
+template <typename T>
+ApproximationHelper::ComplexAndComplexReduction<T>
+CompiledApproximation::BinaryCompute(OpCode opCode) {
+  switch (opCode) {
+    case OpCode::Add:
+      return AdditionNode::computeOnComplex<T>;
+    case OpCode::Subtract:
+      return SubtractionNode::computeOnComplex<T>;
+    case OpCode::Multiply:
+      return MultiplicationNode::computeOnComplex<T>;
+    default:
+      assert(opCode == OpCode::Divide);
+      return DivisionNode::computeOnComplex<T>;
+  }
+}
+
+template <typename T>
+ApproximationHelper::ComplexCompute<T> CompiledApproximation::UnaryCompute(
+    OpCode opCode) {
+  switch (opCode) {
+    case OpCode::Opposite:
+      return ComputeOpposite<T>;
+    case OpCode::AbsoluteValue:
+      return AbsoluteValueNode::computeOnComplex<T>;
+    case OpCode::SquareRoot:
+      return SquareRootNode::computeOnComplex<T>;
+    case OpCode::NaperianLogarithm:
+      return NaperianLogarithmNode::computeOnComplex<T>;
+    case OpCode::Logarithm:
+      return LogarithmNode::computeOnComplex<T>;
+    case OpCode::SignFunction:
+      return SignFunctionNode::computeOnComplex<T>;
+    case OpCode::Sine:
+      return SineNode::computeOnComplex<T>;
+    case OpCode::Cosine:
+      return CosineNode::computeOnComplex<T>;
+    case OpCode::Tangent:
+      return TangentNode::computeOnComplex<T>;
+    case OpCode::ArcSine:
+      return ArcSineNode::computeOnComplex<T>;
+    case OpCode::ArcCosine:
+      return ArcCosineNode::computeOnComplex<T>;
+    case OpCode::ArcTangent:
+      return ArcTangentNode::computeOnComplex<T>;
+    case OpCode::HyperbolicSine:
+      return HyperbolicSineNode::computeOnComplex<T>;
+    case OpCode::HyperbolicCosine:
+      return HyperbolicCosineNode::computeOnComplex<T>;
+    case OpCode::HyperbolicTangent:
+      return HyperbolicTangentNode::computeOnComplex<T>;
+    case OpCode::Floor:
+      return FloorNode::computeOnComplex<T>;
+    default:
+      assert(opCode == OpCode::Ceiling);
+      return CeilingNode::computeOnComplex<T>;
+  }
+}
+
+template float CompiledApproximation::approximateToScalar<float>(float) const;
+template double CompiledApproximation::approximateToScalar<double>(
+    double) const;
+template void CompiledApproximation::approximateToScalars<float>(
+    const float*, float*, int) const;
+template void CompiledApproximation::approximateToScalars<double>(
+    const double*, double*, int) const;
+
+}  // namespace Poincare
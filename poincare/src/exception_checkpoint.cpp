@@ -1,10 +1,14 @@
 #include <assert.h>
 #include <poincare/exception_checkpoint.h>
+#include <poincare/tree_pool.h>
 
 namespace Poincare {
 
 void ExceptionCheckpoint::Raise() {
   assert(s_topmost != nullptr);
+#if POINCARE_POOL_TELEMETRY
+  TreePool::sharedPool->didRaise();
+#endif
   s_topmost->rollbackException();
   assert(false);
 }
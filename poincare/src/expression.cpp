@@ -26,6 +26,7 @@
 #include <poincare/point_evaluation.h>
 #include <poincare/power.h>
 #include <poincare/rational.h>
+#include <poincare/reduction_cache.h>
 #include <poincare/real_part.h>
 #include <poincare/solver.h>
 #include <poincare/store.h>
@@ -43,8 +44,9 @@
 
 namespace Poincare {
 
-static bool s_approximationEncounteredComplex = false;
-static bool s_reductionEncounteredUndistributedList = false;
+static POINCARE_THREAD_LOCAL bool s_approximationEncounteredComplex = false;
+static POINCARE_THREAD_LOCAL bool s_reductionEncounteredUndistributedList =
+    false;
 
 /* Constructor & Destructor */
 
@@ -1445,6 +1447,44 @@ Expression Expression::cloneAndReduceAndRemoveUnit(
 Expression Expression::cloneAndDeepReduceWithSystemCheckpoint(
     ReductionContext *reductionContext, bool *reduceFailure,
     bool approximateDuringReduction) const {
+#if POINCARE_REDUCTION_CACHE
+  ReductionCache *cache = ReductionCache::SharedCache();
+  ReductionCache::Key key;
+  if (cache->computeKey(*this, *reductionContext, approximateDuringReduction,
+                        &key)) {
+    bool encounteredUndistributedList;
+    Expression e = cache->lookup(key, &encounteredUndistributedList);
+    if (!e.isUninitialized()) {
+      *reduceFailure = false;
+      s_reductionEncounteredUndistributedList |= encounteredUndistributedList;
+      return e;
+    }
+    /* Track whether this reduction encounters an undistributed list, to
+     * replay it when the result is retrieved from the cache. */
+    bool previouslyEncounteredUndistributedList =
+        s_reductionEncounteredUndistributedList;
+    s_reductionEncounteredUndistributedList = false;
+    ReductionTarget target = reductionContext->target();
+    e = cloneAndDeepReduceWithSystemCheckpointWithoutCache(
+        reductionContext, reduceFailure, approximateDuringReduction);
+    encounteredUndistributedList = s_reductionEncounteredUndistributedList;
+    s_reductionEncounteredUndistributedList |=
+        previouslyEncounteredUndistributedList;
+    /* Reductions that needed a second attempt depend on the space that was
+     * left in the pool, they are not memoized. */
+    if (!*reduceFailure && reductionContext->target() == target) {
+      cache->store(key, *this, e, encounteredUndistributedList);
+    }
+    return e;
+  }
+#endif
+  return cloneAndDeepReduceWithSystemCheckpointWithoutCache(
+      reductionContext, reduceFailure, approximateDuringReduction);
+}
+
+Expression Expression::cloneAndDeepReduceWithSystemCheckpointWithoutCache(
+    ReductionContext *reductionContext, bool *reduceFailure,
+    bool approximateDuringReduction) const {
   /* We tried first with the supplied ReductionTarget. If the reduction failed
    * without any user interruption (too many nodes were generated), we try again
    * with ReductionTarget::SystemForApproximation. */
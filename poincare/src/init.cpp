@@ -1,5 +1,6 @@
 #include <poincare/init.h>
 #include <poincare/preferences.h>
+#include <poincare/reduction_cache.h>
 #include <poincare/tree_pool.h>
 
 namespace Poincare {
@@ -9,4 +10,12 @@ void Init() {
   TreePool::sharedPool.init();
 }
 
+void Shutdown() {
+  TreePool::sharedPool.deinit();
+#if POINCARE_REDUCTION_CACHE
+  // Entries are keyed by the versions of contexts, which start over
+  ReductionCache::SharedCache()->reset();
+#endif
+}
+
 }  // namespace Poincare
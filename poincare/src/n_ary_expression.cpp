@@ -16,13 +16,15 @@ void NAryExpressionNode::sortChildrenInPlace(ExpressionOrder order,
   const int childrenCount = reference.numberOfChildren();
   for (int i = 1; i < childrenCount; i++) {
     bool isSorted = true;
+    /* Children are reached from their previous sibling rather than with
+     * childAtIndex, which walks through all the previous children. Swapping the
+     * children j and j+1 does not move the address of the child j. */
+    ExpressionNode* cj = childAtIndex(0);
+    bool cjIsMatrix = Expression(cj).deepIsMatrix(context, canContainMatrices);
     for (int j = 0; j < childrenCount - 1; j++) {
       /* Warning: Matrix operations are not always commutative (ie,
        * multiplication) so we never swap 2 matrices. */
-      ExpressionNode* cj = childAtIndex(j);
-      ExpressionNode* cj1 = childAtIndex(j + 1);
-      bool cjIsMatrix =
-          Expression(cj).deepIsMatrix(context, canContainMatrices);
+      ExpressionNode* cj1 = static_cast<ExpressionNode*>(cj->nextSibling());
       bool cj1IsMatrix =
           Expression(cj1).deepIsMatrix(context, canContainMatrices);
       bool cj1GreaterThanCj = order(cj, cj1) > 0;
@@ -32,6 +34,11 @@ void NAryExpressionNode::sortChildrenInPlace(ExpressionOrder order,
           (!cjIsMatrix && !cj1IsMatrix && cj1GreaterThanCj)) {
         reference.swapChildrenInPlace(j, j + 1);
         isSorted = false;
+        // The former child j is now the child j+1
+        cj = static_cast<ExpressionNode*>(cj->nextSibling());
+      } else {
+        cj = cj1;
+        cjIsMatrix = cj1IsMatrix;
       }
     }
     if (isSorted) {
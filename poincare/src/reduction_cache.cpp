@@ -0,0 +1,151 @@
+#include <poincare/context.h>
+#include <poincare/expression_node.h>
+#include <poincare/helpers.h>
+#include <poincare/preferences.h>
+#include <poincare/reduction_cache.h>
+#include <string.h>
+
+namespace Poincare {
+
+static POINCARE_THREAD_LOCAL ReductionCache s_sharedCache;
+
+ReductionCache* ReductionCache::SharedCache() { return &s_sharedCache; }
+
+bool ReductionCache::computeKey(const Expression e,
+                                const ReductionContext& reductionContext,
+                                bool approximateDuringReduction, Key* key) {
+  Context* context = reductionContext.context();
+  if (context == nullptr) {
+    return false;
+  }
+  key->contextVersion = context->versionForReductionCache();
+  if (key->contextVersion == k_noContextVersion) {
+    return false;
+  }
+  /* Leave room for the reduced tree, which is usually not much bigger than
+   * the input tree. */
+  size_t treeSize = CopyTree(e, m_scratch, k_entrySize / 2);
+  if (treeSize == 0) {
+    return false;
+  }
+  TreeNode* root = reinterpret_cast<TreeNode*>(m_scratch);
+  if (static_cast<ExpressionNode*>(root)->isRandom()) {
+    return false;
+  }
+  for (TreeNode* node : root->depthFirstChildren()) {
+    if (static_cast<ExpressionNode*>(node)->isRandom()) {
+      return false;
+    }
+  }
+  key->treeSize = treeSize;
+  key->treeHash = Hash(m_scratch, treeSize);
+  key->parameters =
+      static_cast<uint32_t>(reductionContext.complexFormat()) |
+      static_cast<uint32_t>(reductionContext.angleUnit()) << 4 |
+      static_cast<uint32_t>(reductionContext.unitFormat()) << 8 |
+      static_cast<uint32_t>(reductionContext.target()) << 12 |
+      static_cast<uint32_t>(reductionContext.symbolicComputation()) << 16 |
+      static_cast<uint32_t>(reductionContext.unitConversion()) << 20 |
+      reductionContext.shouldExpandMultiplication() << 24 |
+      reductionContext.shouldCheckMatrices() << 25 |
+      reductionContext.shouldExpandLogarithm() << 26 |
+      approximateDuringReduction << 27 |
+      context->canRemoveUnderscoreToUnits() << 28;
+  /* Some reductions depend on the shared preferences (exam mode, combinatoric
+   * symbols...). */
+  key->preferencesHash =
+      Hash(Preferences::SharedPreferences(), sizeof(Preferences));
+  return true;
+}
+
+Expression ReductionCache::lookup(const Key& key,
+                                  bool* encounteredUndistributedList) {
+  for (Entry& entry : m_entries) {
+    if (!entry.isEmpty() && KeysAreEqual(entry.key, key) &&
+        memcmp(entry.buffer, m_scratch, key.treeSize) == 0) {
+      entry.lastUse = ++m_clock;
+      m_numberOfHits++;
+      *encounteredUndistributedList = entry.encounteredUndistributedList;
+      return Expression::ExpressionFromAddress(entry.reducedTree(),
+                                               entry.reducedSize);
+    }
+  }
+  m_numberOfMisses++;
+  return Expression();
+}
+
+void ReductionCache::store(const Key& key, const Expression e,
+                           const Expression reduced,
+                           bool encounteredUndistributedList) {
+  Entry* victim = &m_entries[0];
+  for (Entry& entry : m_entries) {
+    if (entry.isEmpty()) {
+      victim = &entry;
+      break;
+    }
+    if (entry.lastUse < victim->lastUse) {
+      victim = &entry;
+    }
+  }
+  victim->reducedSize = 0;
+  /* The scratch buffer may have been overwritten by nested reductions, the
+   * input tree is thus copied again. */
+  if (CopyTree(e, victim->buffer, k_entrySize) != key.treeSize) {
+    assert(false);
+    return;
+  }
+  victim->key = key;
+  size_t reducedSize =
+      CopyTree(reduced, victim->reducedTree(), k_entrySize - key.treeSize);
+  if (reducedSize == 0) {
+    return;
+  }
+  victim->reducedSize = reducedSize;
+  victim->encounteredUndistributedList = encounteredUndistributedList;
+  victim->lastUse = ++m_clock;
+}
+
+void ReductionCache::reset() {
+  for (Entry& entry : m_entries) {
+    entry.reducedSize = 0;
+    entry.lastUse = 0;
+  }
+  m_clock = 0;
+  m_numberOfHits = 0;
+  m_numberOfMisses = 0;
+}
+
+size_t ReductionCache::CopyTree(const Expression e, AlignedNodeBuffer* buffer,
+                                size_t bufferSize) {
+  size_t size = e.size();
+  assert(size % sizeof(AlignedNodeBuffer) == 0);
+  if (size > bufferSize || size > UINT16_MAX) {
+    return 0;
+  }
+  memcpy(buffer, e.addressInPool(), size);
+  TreeNode* root = reinterpret_cast<TreeNode*>(buffer);
+  root->eraseIdentifiers();
+  for (TreeNode* node : root->depthFirstChildren()) {
+    node->eraseIdentifiers();
+  }
+  return size;
+}
+
+uint32_t ReductionCache::Hash(const void* data, size_t size) {
+  // FNV-1a
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+bool ReductionCache::KeysAreEqual(const Key& key1, const Key& key2) {
+  return key1.treeHash == key2.treeHash && key1.treeSize == key2.treeSize &&
+         key1.parameters == key2.parameters &&
+         key1.preferencesHash == key2.preferencesHash &&
+         key1.contextVersion == key2.contextVersion;
+}
+
+}  // namespace Poincare
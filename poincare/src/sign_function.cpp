@@ -148,4 +148,11 @@ bool SignFunction::derivate(const ReductionContext& reductionContext,
   return true;
 }
 
+template std::complex<float> SignFunctionNode::computeOnComplex<float>(
+    const std::complex<float>, Preferences::ComplexFormat,
+    Preferences::AngleUnit);
+template std::complex<double> SignFunctionNode::computeOnComplex<double>(
+    const std::complex<double>, Preferences::ComplexFormat,
+    Preferences::AngleUnit);
+
 }  // namespace Poincare
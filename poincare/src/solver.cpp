@@ -91,13 +91,19 @@ Coordinate2D<T> Solver<T>::next(const Expression &e, BracketTest test,
   }
   ApproximationContext approximationContext(m_context, m_complexFormat,
                                             m_angleUnit);
+  CompiledApproximation compiledExpression;
+  compiledExpression.compile(e, m_unknown, approximationContext);
   FunctionEvaluationParameters parameters = {
       .approximationContext = approximationContext,
       .unknown = m_unknown,
-      .expression = e};
+      .expression = e,
+      .compiledExpression = compiledExpression};
   FunctionEvaluation f = [](T x, const void *aux) {
     const FunctionEvaluationParameters *p =
         reinterpret_cast<const FunctionEvaluationParameters *>(aux);
+    if (p->compiledExpression.isCompiled()) {
+      return p->compiledExpression.approximateToScalar(x);
+    }
     return p->expression.approximateToScalarWithValueForSymbol(
         p->unknown, x, p->approximationContext);
   };
@@ -145,14 +145,19 @@ void TreeHandle::swapChildrenInPlace(int i, int j) {
   }
   int firstChildIndex = i < j ? i : j;
   int secondChildIndex = i > j ? i : j;
-  TreeHandle firstChild = childAtIndex(firstChildIndex);
-  TreeHandle secondChild = childAtIndex(secondChildIndex);
-  TreePool::sharedPool->move(firstChild.node()->nextSibling(),
-                             secondChild.node(),
-                             secondChild.numberOfChildren());
-  TreePool::sharedPool->move(
-      childAtIndex(secondChildIndex).node()->nextSibling(), firstChild.node(),
-      firstChild.numberOfChildren());
+  TreeNode *firstChild = node()->childAtIndex(firstChildIndex);
+  TreeNode *secondChild = firstChild;
+  for (int k = firstChildIndex; k < secondChildIndex; k++) {
+    secondChild = secondChild->nextSibling();
+  }
+  int firstNumberOfChildren = firstChild->numberOfChildren();
+  int secondNumberOfChildren = secondChild->numberOfChildren();
+  /* Both moves only rearrange the children between the first child and the
+   * end of the second one, so that these addresses remain valid. */
+  TreeNode *end = secondChild->nextSibling();
+  TreePool::sharedPool->move(firstChild->nextSibling(), secondChild,
+                             secondNumberOfChildren);
+  TreePool::sharedPool->move(end, firstChild, firstNumberOfChildren);
 }
 
 #if POINCARE_TREE_LOG
@@ -288,6 +293,9 @@ TreeHandle TreeHandle::BuildWithGhostChildren(TreeNode *node) {
    * nodes that have a fixed, non-zero number of children. */
   uint16_t nodeIdentifier = pool->generateIdentifier();
   node->rename(nodeIdentifier, false, true);
+#if POINCARE_POOL_TELEMETRY
+  pool->didBuildNode(node);
+#endif
   for (int i = 0; i < expectedNumberOfChildren; i++) {
     GhostNode *ghost = new (pool->alloc(sizeof(GhostNode))) GhostNode();
     ghost->rename(pool->generateIdentifier(), false);
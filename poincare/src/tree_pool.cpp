@@ -9,10 +9,31 @@
 namespace Poincare {
 
 #if ASSERTIONS
-bool TreePool::s_treePoolLocked = false;
+POINCARE_THREAD_LOCAL bool TreePool::s_treePoolLocked = false;
 #endif
 
-OMG::GlobalBox<TreePool> TreePool::sharedPool;
+POINCARE_THREAD_LOCAL OMG::GlobalBox<TreePool> TreePool::sharedPool;
+
+#if POINCARE_POOL_TELEMETRY
+void TreePool::resetTelemetry() {
+  resetPeakSize();
+  m_telemetry.numberOfRaises = 0;
+  for (int i = 0; i < Telemetry::k_numberOfTypes; i++) {
+    m_telemetry.numberOfExpressions[i] = 0;
+  }
+  m_telemetry.numberOfOtherNodes = 0;
+}
+
+void TreePool::didBuildNode(const TreeNode *node) {
+  int type = node->telemetryType();
+  assert(type < Telemetry::k_numberOfTypes);
+  if (type < 0) {
+    m_telemetry.numberOfOtherNodes++;
+  } else {
+    m_telemetry.numberOfExpressions[type]++;
+  }
+}
+#endif
 
 void TreePool::freeIdentifier(uint16_t identifier) {
   if (TreeNode::IsValidIdentifier(identifier) &&
@@ -35,16 +56,34 @@ void TreePool::moveChildren(TreeNode *destination, TreeNode *sourceParent) {
 }
 
 void TreePool::removeChildren(TreeNode *node, int nodeNumberOfChildren) {
+  if (nodeNumberOfChildren == 0) {
+    node->eraseNumberOfChildren();
+    return;
+  }
+  /* Move all the children at once at the end of the pool rather than one by
+   * one, which would shift the rest of the pool for each of them. */
+  TreeNode *firstChild = node->next();
+  size_t childrenSize = 0;
+  for (int i = 0; i < nodeNumberOfChildren; i++) {
+    TreeNode *child = reinterpret_cast<TreeNode *>(
+        reinterpret_cast<char *>(firstChild) + childrenSize);
+    childrenSize += child->deepSize(child->numberOfChildren());
+  }
+  /* The children will be put at the address last(), but removed from their
+   * previous position, hence the address we use. */
+  TreeNode *child = reinterpret_cast<TreeNode *>(
+      reinterpret_cast<char *>(last()) - childrenSize);
+  moveNodes(last(), firstChild, childrenSize);
   for (int i = 0; i < nodeNumberOfChildren; i++) {
-    TreeNode *child = node->childAtIndex(0);
-    int childNumberOfChildren = child->numberOfChildren();
-    /* The new child will be put at the address last(), but removed from its
-     * previous position, hence the newAddress we use. */
-    TreeNode *newAddress =
-        (TreeNode *)((char *)last() -
-                     (char *)child->deepSize(childNumberOfChildren));
-    move(last(), child, childNumberOfChildren);
-    newAddress->release(newAddress->numberOfChildren());
+    /* Releasing a child can destroy it and move the following ones, which are
+     * thus retrieved from their identifier. */
+    uint16_t nextChildIdentifier = i < nodeNumberOfChildren - 1
+                                       ? child->nextSibling()->identifier()
+                                       : TreeNode::NoNodeIdentifier;
+    child->release(child->numberOfChildren());
+    if (nextChildIdentifier != TreeNode::NoNodeIdentifier) {
+      child = this->node(nextChildIdentifier);
+    }
   }
   node->eraseNumberOfChildren();
 }
@@ -59,9 +98,17 @@ TreeNode *TreePool::copyTreeFromAddress(const void *address, size_t size) {
   memcpy(ptr, address, size);
   TreeNode *copy = reinterpret_cast<TreeNode *>(ptr);
   renameNode(copy, false);
+#if POINCARE_POOL_TELEMETRY
+  didBuildNode(copy);
+#endif
   for (TreeNode *child : copy->depthFirstChildren()) {
     renameNode(child, false);
     child->retain();
+#if POINCARE_POOL_TELEMETRY
+    if (!child->isGhost()) {
+      didBuildNode(child);
+    }
+#endif
   }
   return copy;
 }
@@ -89,7 +136,14 @@ void TreePool::moveNodes(TreeNode *destination, TreeNode *source,
   size_t len = moveSize / 4;
 
   if (Helpers::Rotate(dst, src, len)) {
-    updateNodeForIdentifierFromNode(dst < src ? destination : source);
+    // Only the nodes between the source and the destination have moved
+    char *start = reinterpret_cast<char *>(dst < src ? destination : source);
+    char *end = dst < src ? reinterpret_cast<char *>(source) + moveSize
+                          : reinterpret_cast<char *>(destination);
+    for (TreeNode *n = reinterpret_cast<TreeNode *>(start);
+         reinterpret_cast<char *>(n) < end; n = n->next()) {
+      registerNode(n);
+    }
   }
 }
 
@@ -140,6 +194,17 @@ void *TreePool::alloc(size_t size) {
   }
   void *result = m_cursor;
   m_cursor += size;
+#if POINCARE_REDUCTION_CACHE
+  /* Clear the padding bytes of the node, so that identical nodes are identical
+   * bytes, which is how the ReductionCache compares trees. */
+  memset(result, 0, size);
+#endif
+#if POINCARE_POOL_TELEMETRY
+  size_t currentSize = m_cursor - buffer();
+  if (currentSize > m_telemetry.peakSize) {
+    m_telemetry.peakSize = currentSize;
+  }
+#endif
   return result;
 }
 
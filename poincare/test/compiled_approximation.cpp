@@ -0,0 +1,110 @@
+#include <apps/shared/global_context.h>
+#include <poincare/compiled_approximation.h>
+
+#include "helper.h"
+
+using namespace Poincare;
+
+template <typename T>
+void assert_compiled_approximation_matches_tree(
+    const CompiledApproximation& compiled, const Expression e,
+    const ApproximationContext& approximationContext, const char* expression) {
+  constexpr T k_values[] = {-1000.,   -10.,  -3.5,          -2., -1.,
+                            -0.5,     -0.,   0.,            0.5, 1.,
+                            2.,       3.14,  10.,           90., 1e10,
+                            -INFINITY, INFINITY, static_cast<T>(NAN)};
+  constexpr int k_numberOfValues = std::size(k_values);
+  T batchResults[k_numberOfValues];
+  compiled.approximateToScalars<T>(k_values, batchResults, k_numberOfValues);
+  for (int i = 0; i < k_numberOfValues; i++) {
+    T expected = e.approximateToScalarWithValueForSymbol<T>("x", k_values[i],
+                                                            approximationContext);
+    T observed = compiled.approximateToScalar<T>(k_values[i]);
+    quiz_assert_print_if_failure(
+        (std::isnan(expected) && std::isnan(observed)) || expected == observed,
+        expression);
+    quiz_assert_print_if_failure(
+        (std::isnan(observed) && std::isnan(batchResults[i])) ||
+            observed == batchResults[i],
+        expression);
+  }
+}
+
+void assert_compiles_like_tree(
+    const char* expression, bool canBeCompiled = true,
+    Preferences::ComplexFormat complexFormat = Real,
+    Preferences::AngleUnit angleUnit = Radian) {
+  Shared::GlobalContext context;
+  Expression e = parse_expression(expression, &context, false);
+  e = e.cloneAndReduce(ReductionContext(&context, complexFormat, angleUnit,
+                                        MetricUnitFormat,
+                                        SystemForApproximation));
+  ApproximationContext approximationContext(&context, complexFormat,
+                                            angleUnit);
+  CompiledApproximation compiled;
+  compiled.compile(e, "x", approximationContext);
+  quiz_assert_print_if_failure(compiled.isCompiled() == canBeCompiled,
+                               expression);
+  quiz_assert(compiled.isValidFor(approximationContext));
+  if (canBeCompiled) {
+    assert_compiled_approximation_matches_tree<float>(
+        compiled, e, approximationContext, expression);
+    assert_compiled_approximation_matches_tree<double>(
+        compiled, e, approximationContext, expression);
+  }
+}
+
+QUIZ_CASE(poincare_compiled_approximation_matches_tree) {
+  assert_compiles_like_tree("3");
+  assert_compiles_like_tree("x");
+  assert_compiles_like_tree("-x");
+  assert_compiles_like_tree("3x^2-2x+1");
+  assert_compiles_like_tree("(x+1)/(x-1)");
+  assert_compiles_like_tree("1/x");
+  assert_compiles_like_tree("x^x");
+  assert_compiles_like_tree("x^(1/3)");
+  assert_compiles_like_tree("x^(2/3)");
+  assert_compiles_like_tree("x^(-1/5)");
+  assert_compiles_like_tree("√(x)");
+  assert_compiles_like_tree("√(x)^2");
+  assert_compiles_like_tree("e^x");
+  assert_compiles_like_tree("e^(-x^2/2)");
+  assert_compiles_like_tree("ln(x)");
+  assert_compiles_like_tree("log(x)");
+  assert_compiles_like_tree("log(x,3)");
+  assert_compiles_like_tree("abs(x)");
+  assert_compiles_like_tree("sign(x-1)");
+  assert_compiles_like_tree("floor(x)+ceil(x)");
+  assert_compiles_like_tree("sin(x)+cos(2x)");
+  assert_compiles_like_tree("tan(x)");
+  assert_compiles_like_tree("sin(x)", true, Real, Degree);
+  assert_compiles_like_tree("cos(πx)", true, Real, Gradian);
+  assert_compiles_like_tree("arcsin(x)+arccos(x)+arctan(x)");
+  assert_compiles_like_tree("arcsin(x)", true, Real, Degree);
+  assert_compiles_like_tree("sinh(x)-cosh(x)+tanh(x)");
+  assert_compiles_like_tree("x^2/x");
+  assert_compiles_like_tree("ln(x)+ln(-x)");
+  assert_compiles_like_tree("√(x)", true, Cartesian);
+  assert_compiles_like_tree("x^(1/3)", true, Cartesian);
+  assert_compiles_like_tree("ln(x)^2", true, Cartesian);
+  assert_compiles_like_tree("3x^2-2x+1", true, Cartesian);
+  assert_compiles_like_tree("x+sum((-1)^(k/2),k,0,3)", true, Cartesian);
+}
+
+QUIZ_CASE(poincare_compiled_approximation_fallback) {
+  // These expressions cannot be lowered and fall back on the tree evaluation
+  assert_compiles_like_tree("random()x", false);
+  assert_compiles_like_tree("int(t^2,t,0,x)", false);
+  assert_compiles_like_tree("x!", false);
+  assert_compiles_like_tree("{1,2}x", false);
+  assert_compiles_like_tree("xy", false);
+  assert_compiles_like_tree("piecewise(x,x>0,-x)", false);
+  /* The constant sum is real but its terms are not, the tree evaluation is
+   * undefined in Real format */
+  assert_compiles_like_tree("x+sum((-1)^(k/2),k,0,3)", false);
+  CompiledApproximation compiled;
+  quiz_assert(compiled.isUninitialized());
+  Shared::GlobalContext context;
+  compiled.compile(Expression(), "x", ApproximationContext(&context));
+  quiz_assert(!compiled.isCompiled() && !compiled.isUninitialized());
+}
@@ -2,6 +2,7 @@
 #include <poincare/addition.h>
 #include <poincare/constant.h>
 #include <poincare/decimal.h>
+#include <poincare/exception_checkpoint.h>
 #include <poincare/expression.h>
 #include <poincare/power.h>
 #include <poincare/rational.h>
@@ -117,6 +118,39 @@ QUIZ_CASE(poincare_number_of_numerical_values) {
   assert_number_of_numerical_values("ln(1+inf)", -1);
 }
 
+QUIZ_CASE(poincare_expression_pool_telemetry) {
+#if POINCARE_POOL_TELEMETRY
+  TreePool::sharedPool->resetTelemetry();
+  const TreePool::Telemetry& telemetry = TreePool::sharedPool->telemetry();
+  {
+    Expression e = Addition::Builder(Rational::Builder(1),
+                                     Power::Builder(Rational::Builder(2),
+                                                    Rational::Builder(3)));
+    size_t peakSize = telemetry.peakSize;
+    quiz_assert(peakSize > 0);
+    Expression f = e.clone();
+    quiz_assert(telemetry.peakSize == 2 * peakSize);
+  }
+  constexpr int k_addition = static_cast<int>(ExpressionNode::Type::Addition);
+  constexpr int k_power = static_cast<int>(ExpressionNode::Type::Power);
+  constexpr int k_rational = static_cast<int>(ExpressionNode::Type::Rational);
+  quiz_assert(telemetry.numberOfExpressions[k_addition] == 2);
+  quiz_assert(telemetry.numberOfExpressions[k_power] == 2);
+  quiz_assert(telemetry.numberOfExpressions[k_rational] == 6);
+  quiz_assert(telemetry.numberOfRaises == 0);
+  quiz_assert(telemetry.numberOfOtherNodes == 0);
+  ExceptionCheckpoint ecp;
+  if (ExceptionRun(ecp)) {
+    Expression e = Rational::Builder(1);
+    while (true) {
+      e = Addition::Builder(e, Rational::Builder(1));
+    }
+  }
+  quiz_assert(telemetry.numberOfRaises == 1);
+  quiz_assert(telemetry.peakSize > TreePool::Size() - 64);
+#endif
+}
+
 static inline void assert_generalizes_to_and_extract(const char* expression,
                                                      const char* generalized,
                                                      float value) {
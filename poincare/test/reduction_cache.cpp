@@ -0,0 +1,73 @@
+#include <apps/shared/global_context.h>
+#include <ion/storage/file_system.h>
+#include <poincare/reduction_cache.h>
+#include <poincare/variable_context.h>
+
+#include "helper.h"
+
+using namespace Poincare;
+
+#if POINCARE_REDUCTION_CACHE
+static Expression reduce(const char* expression, Context* context,
+                         Preferences::AngleUnit angleUnit) {
+  Expression e = parse_expression(expression, context, false);
+  return e.cloneAndReduce(
+      ReductionContext(context, Cartesian, angleUnit, MetricUnitFormat, User));
+}
+
+static void assert_reduction_hits_cache(
+    const char* expression, Context* context, bool hit,
+    Preferences::AngleUnit angleUnit = Radian) {
+  ReductionCache* cache = ReductionCache::SharedCache();
+  int numberOfHits = cache->numberOfHits();
+  Expression e = reduce(expression, context, angleUnit);
+  quiz_assert_print_if_failure(
+      (cache->numberOfHits() == numberOfHits + 1) == hit, expression);
+  // A VariableContext has no version, its reductions are never memoized
+  VariableContext uncachedContext("z", context);
+  Expression expected = reduce(expression, &uncachedContext, angleUnit);
+  quiz_assert_print_if_failure(cache->numberOfHits() == numberOfHits + hit,
+                               expression);
+  quiz_assert_print_if_failure(e.isIdenticalTo(expected), expression);
+}
+#endif
+
+QUIZ_CASE(poincare_reduction_cache) {
+#if POINCARE_REDUCTION_CACHE
+  Shared::GlobalContext context;
+  ReductionCache::SharedCache()->reset();
+
+  assert_reduction_hits_cache("3x^2+2x-x", &context, false);
+  assert_reduction_hits_cache("3x^2+2x-x", &context, true);
+  assert_reduction_hits_cache("3x^2+2x-x", &context, true);
+
+  // The key depends on the reduction context
+  assert_reduction_hits_cache("cos(x)", &context, false);
+  assert_reduction_hits_cache("cos(x)", &context, false, Degree);
+  assert_reduction_hits_cache("cos(x)", &context, true);
+
+  // The key depends on the symbols definitions
+  assert_reduction_hits_cache("a+1", &context, false);
+  assert_reduce_and_store("2→a");
+  assert_reduction_hits_cache("a+1", &context, false);
+  assert_reduction_hits_cache("a+1", &context, true);
+  Ion::Storage::FileSystem::sharedFileSystem->recordNamed("a.exp").destroy();
+  assert_reduction_hits_cache("a+1", &context, false);
+
+  // Random expressions are not memoized
+  assert_reduction_hits_cache("random()+1", &context, false);
+  assert_reduction_hits_cache("random()+1", &context, false);
+
+  // The least recently used entry is replaced when the cache is full
+  char buffer[] = "x+??";
+  for (int i = 0; i < ReductionCache::k_numberOfEntries; i++) {
+    buffer[2] = '1' + i / 10;
+    buffer[3] = '0' + i % 10;
+    assert_reduction_hits_cache(buffer, &context, false);
+  }
+  assert_reduction_hits_cache("x+10", &context, true);
+  assert_reduction_hits_cache("3x^2+2x-x", &context, false);
+
+  ReductionCache::SharedCache()->reset();
+#endif
+}
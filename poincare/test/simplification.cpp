@@ -2,12 +2,14 @@
 #include <poincare/constant.h>
 #include <poincare/function.h>
 #include <poincare/infinity.h>
+#include <poincare/print.h>
 #include <poincare/rational.h>
 #include <poincare/store.h>
 #include <poincare/symbol.h>
 #include <poincare/undefined.h>
 #include <poincare/unit.h>
 #include <poincare/unit_convert.h>
+#include <quiz/stopwatch.h>
 
 #include "helper.h"
 
@@ -3027,3 +3029,32 @@ QUIZ_CASE(poincare_simplification_point) {
   assert_parsed_expression_simplify_to("sequence((k,-k+1),k,4)",
                                        "{(1,0),(2,-1),(3,-2),(4,-3)}");
 }
+
+static void assert_large_expression_simplifies_to(const char* term,
+                                                  const char* separator,
+                                                  int numberOfTerms,
+                                                  const char* simplified) {
+  constexpr int k_bufferSize = 2048;
+  char buffer[k_bufferSize];
+  int length = 0;
+  for (int i = 1; i <= numberOfTerms; i++) {
+    if (i > 1) {
+      length += strlcpy(buffer + length, separator, k_bufferSize - length);
+    }
+    length += Print::CustomPrintf(buffer + length, k_bufferSize - length, term,
+                                  i, i % 5 + 1);
+    assert(length < k_bufferSize - 1);
+  }
+  uint64_t startTime = quiz_stopwatch_start();
+  assert_parsed_expression_simplify_to(buffer, simplified);
+  quiz_stopwatch_print_lap(startTime);
+}
+
+QUIZ_CASE(poincare_simplification_large_expressions) {
+  /* These sums and products exercise the moves of nodes in the pool during
+   * the reduction. Their duration is printed to track its performance. */
+  assert_large_expression_simplifies_to(
+      "%i×x^%i", "+", 150, "2295×x^5+2265×x^4+2235×x^3+2205×x^2+2325×x");
+  assert_large_expression_simplifies_to("x^%i×y^%i", "×", 150,
+                                        "x^11325×y^450");
+}
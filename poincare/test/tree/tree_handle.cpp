@@ -3,6 +3,10 @@
 #include <poincare/tree_handle.h>
 #include <quiz.h>
 
+#if POINCARE_THREAD_LOCAL_POOL
+#include <thread>
+#endif
+
 #include "blob_node.h"
 #include "helpers.h"
 #include "pair_node.h"
@@ -76,6 +80,45 @@ QUIZ_CASE(tree_handle_memory_failure) {
   assert_pool_size(initialPoolSize);
 }
 
+#if POINCARE_THREAD_LOCAL_POOL
+static void fill_own_pool(bool* memoryFailureHasBeenHandled) {
+  TreePool::sharedPool.init();
+  {
+    Poincare::ExceptionCheckpoint ecp;
+    if (ExceptionRun(ecp)) {
+      TreeHandle tree = BlobByReference::Builder(1);
+      while (true) {
+        tree = PairByReference::Builder(tree, BlobByReference::Builder(1));
+      }
+    } else {
+      *memoryFailureHasBeenHandled = pool_size() == 0;
+    }
+  }
+  TreePool::sharedPool.deinit();
+}
+#endif
+
+QUIZ_CASE(tree_handle_memory_failure_on_several_threads) {
+#if POINCARE_THREAD_LOCAL_POOL
+  /* Each thread exhausts its own pool and rolls back to its own checkpoint,
+   * without altering the pool of the other threads. */
+  constexpr int k_numberOfThreads = 4;
+  int initialPoolSize = pool_size();
+  BlobByReference b = BlobByReference::Builder(1);
+  bool memoryFailureHasBeenHandled[k_numberOfThreads] = {};
+  std::thread threads[k_numberOfThreads];
+  for (int i = 0; i < k_numberOfThreads; i++) {
+    threads[i] = std::thread(fill_own_pool, memoryFailureHasBeenHandled + i);
+  }
+  for (int i = 0; i < k_numberOfThreads; i++) {
+    threads[i].join();
+    quiz_assert(memoryFailureHasBeenHandled[i]);
+  }
+  assert_pool_size(initialPoolSize + 1);
+  quiz_assert(b.data() == 1);
+#endif
+}
+
 QUIZ_CASE(tree_handle_does_not_copy) {
   int initialPoolSize = pool_size();
   BlobByReference b1 = BlobByReference::Builder(1);
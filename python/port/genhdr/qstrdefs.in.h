@@ -54,6 +54,9 @@ Q(KeyboardInterrupt)
 Q(LookupError)
 Q(MemoryError)
 Q(NameError)
+#if PYTHON_NATIVE_EMITTER
+Q(None)
+#endif
 Q(NoneType)
 Q(NotImplementedError)
 Q(OSError)
@@ -65,6 +68,9 @@ Q(SystemExit)
 Q(TypeError)
 Q(UnicodeError)
 Q(ValueError)
+#if PYTHON_NATIVE_EMITTER
+Q(ViperTypeError)
+#endif
 Q(ZeroDivisionError)
 Q(_0x0a_)
 Q(__add__)
@@ -247,6 +253,9 @@ Q(micropython)
 Q(min)
 Q(modf)
 Q(module)
+#if PYTHON_NATIVE_EMITTER
+Q(native)
+#endif
 Q(next)
 Q(object)
 Q(oct)
@@ -261,6 +270,12 @@ Q(pop)
 Q(popitem)
 Q(pow)
 Q(print)
+#if PYTHON_NATIVE_EMITTER
+Q(ptr)
+Q(ptr16)
+Q(ptr32)
+Q(ptr8)
+#endif
 #if __EMSCRIPTEN__
 Q(pystack_space_exhausted)
 Q(pystack_use)
@@ -313,12 +328,18 @@ Q(to_bytes)
 Q(trunc)
 Q(tuple)
 Q(type)
+#if PYTHON_NATIVE_EMITTER
+Q(uint)
+#endif
 Q(uniform)
 Q(union)
 Q(update)
 Q(upper)
 Q(value)
 Q(values)
+#if PYTHON_NATIVE_EMITTER
+Q(viper)
+#endif
 Q(zip)
 
 // Ion QSTR
@@ -374,10 +395,13 @@ Q(KEY_EXE)
 // Kandinsky QSTRs
 Q(kandinsky)
 Q(color)
+Q(draw_polyline)
 Q(draw_string)
 Q(fill_rect)
 Q(get_pixel)
+Q(get_pixels)
 Q(set_pixel)
+Q(set_pixels)
 
 // Matplotlib QSTRs
 Q(arrow)
@@ -2,27 +2,74 @@
 
 #include <ion.h>
 
+#include <algorithm>
+
 #include "port.h"
 extern "C" {
 #include "mphalport.h"
+#if PYTHON_NATIVE_EMITTER
+#include "py/misc.h"
+#endif
+}
+
+#if PYTHON_NATIVE_EMITTER
+#include <ion/executable_memory.h>
+#endif
+
+/* Doing too many things in the VM loop hook slows down Python execution quite
+ * a lot. Even reading the clock is expensive compared to a loop iteration, so
+ * the clock is only read once every sHitsBetweenClockReads calls. This number
+ * follows the measured speed of the script so that the clock is read about
+ * every k_clockReadPeriod. It is kept low and drops back to 1 as soon as an
+ * iteration gets slow, so that a loop that turns slow, like a game loop after
+ * a tight loop, is not interrupted or refreshed late. */
+constexpr static uint64_t k_refreshDelay = 100;
+constexpr static uint64_t k_clockReadPeriod = k_refreshDelay / 10;
+constexpr static int32_t k_maxHitsBetweenClockReads = 256;
+static int32_t sHitsBetweenClockReads;
+static int32_t sRemainingHits;
+static bool sClockWasRead;
+static uint64_t sLastClockRead;
+static uint64_t sLastRefresh;
+
+void micropython_port_vm_hook_reset() {
+  sHitsBetweenClockReads = 1;
+  sRemainingHits = 1;
+  sClockWasRead = false;
 }
 
 bool micropython_port_vm_hook_loop() {
   /* This function is called very frequently by the MicroPython engine. We grab
    * this opportunity to interrupt execution and/or refresh the display on
    * platforms that need it. */
+  if (--sRemainingHits > 0) {
+    return false;
+  }
 
-  /* Doing too many things here slows down Python execution quite a lot. So we
-   * only do things once in a while and return as soon as possible otherwise. */
-
-  static uint64_t t = Ion::Timing::millis();
-  constexpr static uint64_t delay = 100;
+  uint64_t t = Ion::Timing::millis();
+  if (!sClockWasRead) {
+    sClockWasRead = true;
+    sLastClockRead = t;
+    sLastRefresh = t;
+  }
+  uint64_t elapsed = t - sLastClockRead;
+  sLastClockRead = t;
+  if (elapsed > k_refreshDelay) {
+    sHitsBetweenClockReads = 1;
+  } else {
+    int64_t hits = static_cast<int64_t>(sHitsBetweenClockReads) *
+                   k_clockReadPeriod / (elapsed > 0 ? elapsed : 1);
+    // Grow at most twofold, elapsed is too coarse to be trusted when short
+    hits = std::min<int64_t>(hits, 2 * sHitsBetweenClockReads);
+    hits = std::min<int64_t>(hits, k_maxHitsBetweenClockReads);
+    sHitsBetweenClockReads = std::max<int64_t>(hits, 1);
+  }
+  sRemainingHits = sHitsBetweenClockReads;
 
-  uint64_t t2 = Ion::Timing::millis();
-  if (t2 - t < delay) {
+  if (t - sLastRefresh < k_refreshDelay) {
     return false;
   }
-  t = t2;
+  sLastRefresh = t;
 
   micropython_port_vm_hook_refresh_print();
   // Check if the user asked for an interruption from the keyboard
@@ -88,3 +135,13 @@ bool micropython_port_interrupt_if_needed() {
 }
 
 int micropython_port_random() { return Ion::random(); }
+
+#if PYTHON_NATIVE_EMITTER
+void micropython_port_alloc_exec(size_t min_size, void **ptr, size_t *size) {
+  *ptr = Ion::ExecutableMemory::allocate(min_size);
+  if (*ptr == nullptr) {
+    m_malloc_fail(min_size);
+  }
+  *size = min_size;
+}
+#endif
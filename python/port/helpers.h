@@ -6,14 +6,25 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+// Forget the pace of the previous script
+void micropython_port_vm_hook_reset();
 // These methods return true if they have been interrupted
 bool micropython_port_vm_hook_loop();
 void micropython_port_vm_hook_refresh_print();
 bool micropython_port_interruptible_msleep(int32_t delay);
 bool micropython_port_interrupt_if_needed();
 int micropython_port_random();
+/* Compile a script to import it, or load it from the bytecode the script
+ * provider kept when it was last compiled */
+struct _mp_raw_code_t *micropython_port_raw_code_from_file(
+    const char *filename);
+#if PYTHON_NATIVE_EMITTER
+// Raises a MemoryError if there is not enough executable memory left
+void micropython_port_alloc_exec(size_t min_size, void **ptr, size_t *size);
+#endif
 
 #ifdef __cplusplus
 }
@@ -3,6 +3,7 @@ extern "C" {
 
 #include <py/runtime.h>
 }
+#include <ion/display.h>
 #include <kandinsky/ion_context.h>
 
 #include "port.h"
@@ -95,3 +96,116 @@ mp_obj_t modkandinsky_fill_rect(size_t n_args, const mp_obj_t *args) {
   KDIonContext::SharedContext->fillRect(rect, color);
   return mp_const_none;
 }
+
+/* The bulk functions take the pixels as RGB565 values, in any object with the
+ * buffer protocol, like bytes or a numpy array of uint16. They are pushed or
+ * pulled with a single call, which spares the per pixel overhead of set_pixel
+ * and get_pixel. */
+
+static KDCoordinate CoordinateFromObj(mp_obj_t obj) {
+  mp_int_t coordinate = mp_obj_get_int(obj);
+  if (coordinate < KDCOORDINATE_MIN || coordinate > KDCOORDINATE_MAX) {
+    mp_raise_ValueError("coordinate out of range");
+  }
+  return coordinate;
+}
+
+/* The size is bounded by the screen size, so that the number of pixels and
+ * their size in bytes cannot overflow, and the rect by the KDCoordinate range.
+ */
+static KDRect RectFromArgs(const mp_obj_t *args, size_t *numberOfPixels) {
+  KDCoordinate x = CoordinateFromObj(args[0]);
+  KDCoordinate y = CoordinateFromObj(args[1]);
+  mp_int_t width = mp_obj_get_int(args[2]);
+  mp_int_t height = mp_obj_get_int(args[3]);
+  if (width < 0 || height < 0) {
+    mp_raise_ValueError("negative size");
+  }
+  if (width > Ion::Display::Width || height > Ion::Display::Height ||
+      SumOverflowsKDCoordinate(x, width) ||
+      SumOverflowsKDCoordinate(y, height)) {
+    mp_raise_ValueError("size too large");
+  }
+  *numberOfPixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+  return KDRect(x, y, width, height);
+}
+
+static void GetPixelBuffer(mp_obj_t buffer, mp_buffer_info_t *bufferInfo,
+                           mp_uint_t flags, size_t numberOfPixels) {
+  mp_get_buffer_raise(buffer, bufferInfo, flags);
+  // Reject the arrays of floats, which are not colors
+  if (bufferInfo->typecode != 'B' && bufferInfo->typecode != 'H') {
+    mp_raise_TypeError("pixels must be bytes or uint16");
+  }
+  if (bufferInfo->len < numberOfPixels * sizeof(KDColor)) {
+    mp_raise_ValueError("not enough pixels");
+  }
+}
+
+mp_obj_t modkandinsky_get_pixels(size_t n_args, const mp_obj_t *args) {
+  size_t numberOfPixels;
+  KDRect rect = RectFromArgs(args, &numberOfPixels);
+  mp_obj_t result;
+  KDColor *pixels;
+  if (n_args == 5) {
+    mp_buffer_info_t bufferInfo;
+    GetPixelBuffer(args[4], &bufferInfo, MP_BUFFER_WRITE, numberOfPixels);
+    result = args[4];
+    pixels = static_cast<KDColor *>(bufferInfo.buf);
+  } else {
+    vstr_t vstr;
+    vstr_init_len(&vstr, numberOfPixels * sizeof(KDColor));
+    pixels = reinterpret_cast<KDColor *>(vstr.buf);
+    result = mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+  }
+  KDIonContext::SharedContext->getPixels(rect, pixels);
+  return result;
+}
+
+mp_obj_t modkandinsky_set_pixels(size_t n_args, const mp_obj_t *args) {
+  size_t numberOfPixels;
+  KDRect rect = RectFromArgs(args, &numberOfPixels);
+  mp_buffer_info_t bufferInfo;
+  GetPixelBuffer(args[4], &bufferInfo, MP_BUFFER_READ, numberOfPixels);
+  const KDColor *pixels = static_cast<const KDColor *>(bufferInfo.buf);
+  /* The data of bytes built from a literal may not be aligned on the size of
+   * a KDColor. */
+  KDColor *alignedPixels = nullptr;
+  if (reinterpret_cast<uintptr_t>(pixels) % alignof(KDColor) != 0) {
+    alignedPixels = m_new(KDColor, numberOfPixels);
+    memcpy(alignedPixels, pixels, numberOfPixels * sizeof(KDColor));
+    pixels = alignedPixels;
+  }
+  MicroPython::ExecutionEnvironment::currentExecutionEnvironment()
+      ->displaySandbox();
+  KDIonContext::SharedContext->fillRectWithPixels(rect, pixels, nullptr);
+  if (alignedPixels) {
+    m_del(KDColor, alignedPixels, numberOfPixels);
+  }
+  return mp_const_none;
+}
+
+mp_obj_t modkandinsky_draw_polyline(mp_obj_t xs, mp_obj_t ys,
+                                    mp_obj_t input) {
+  size_t numberOfPoints = mp_obj_get_int(mp_obj_len(xs));
+  if (static_cast<size_t>(mp_obj_get_int(mp_obj_len(ys))) != numberOfPoints) {
+    mp_raise_ValueError("x and y must be the same size");
+  }
+  KDColor color = MicroPython::Color::Parse(input);
+  KDPoint *points = m_new(KDPoint, numberOfPoints);
+  mp_obj_t xIterable = mp_getiter(xs, nullptr);
+  mp_obj_t yIterable = mp_getiter(ys, nullptr);
+  for (size_t i = 0; i < numberOfPoints; i++) {
+    points[i] = KDPoint(CoordinateFromObj(mp_iternext(xIterable)),
+                        CoordinateFromObj(mp_iternext(yIterable)));
+  }
+  MicroPython::ExecutionEnvironment::currentExecutionEnvironment()
+      ->displaySandbox();
+  KDIonContext::SharedContext->drawPolyline(points, numberOfPoints, color);
+  // Unlike with drawPolyline, the last point is drawn
+  if (numberOfPoints > 0) {
+    KDIonContext::SharedContext->setPixel(points[numberOfPoints - 1], color);
+  }
+  m_del(KDPoint, points, numberOfPoints);
+  return mp_const_none;
+}
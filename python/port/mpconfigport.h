@@ -127,6 +127,26 @@
 
 #define MICROPY_VM_HOOK_LOOP micropython_port_vm_hook_loop();
 
+// Whether to load and save compiled scripts
+#define MICROPY_PERSISTENT_CODE_LOAD (1)
+#define MICROPY_PERSISTENT_CODE_SAVE (1)
+
+// Imported scripts are compiled or loaded by the port, which caches them
+#define MICROPY_PORT_RAW_CODE_FROM_FILE micropython_port_raw_code_from_file
+
+#if PYTHON_NATIVE_EMITTER
+// Whether to emit x64 native code
+#define MICROPY_EMIT_X64 (1)
+
+/* The native code is written to the executable memory provided by Ion, which
+ * is out of the heap and reclaimed at once when MicroPython is deinitialized.
+ * The code holds no pointer to the heap: the objects it uses are loaded from
+ * the constant table of its raw code, which the garbage collector scans. */
+#define MP_PLAT_ALLOC_EXEC(min_size, ptr, size) \
+  micropython_port_alloc_exec(min_size, ptr, size)
+#define MP_PLAT_FREE_EXEC(ptr, size)
+#endif
+
 typedef intptr_t mp_int_t;    // must be pointer size
 typedef uintptr_t mp_uint_t;  // must be pointer size
 
@@ -15,6 +15,7 @@
 #endif
 
 extern "C" {
+#include "helpers.h"
 #include "mod/matplotlib/pyplot/modpyplot.h"
 #include "mod/turtle/modturtle.h"
 #include "mphalport.h"
@@ -26,14 +27,19 @@ extern "C" {
 #include "py/mphal.h"
 #include "py/nlr.h"
 #include "py/parsenum.h"
+#include "py/persistentcode.h"
 #include "py/repl.h"
 #include "py/runtime.h"
 #include "py/stackctrl.h"
 }
 
 #include <escher/palette.h>
+#if PYTHON_NATIVE_EMITTER
+#include <ion/executable_memory.h>
+#endif
 
 static MicroPython::ScriptProvider *sScriptProvider = nullptr;
+static bool sIsInitialized = false;
 static MicroPython::ExecutionEnvironment *sCurrentExecutionEnvironment =
     nullptr;
 
@@ -177,9 +183,27 @@ void MicroPython::init(void *heapStart, void *heapEnd) {
 #endif
   gc_init(heapStart, heapEnd);
   mp_init();
+  micropython_port_vm_hook_reset();
+  sIsInitialized = true;
+}
+
+void MicroPython::deinit() {
+  mp_deinit();
+#if PYTHON_NATIVE_EMITTER
+  // The native code of the scripts is gone with the heap
+  Ion::ExecutableMemory::reset();
+#endif
+  sIsInitialized = false;
 }
 
-void MicroPython::deinit() { mp_deinit(); }
+bool MicroPython::isInitialized() { return sIsInitialized; }
+
+size_t MicroPython::usedHeapSize() {
+  assert(sIsInitialized);
+  gc_info_t info;
+  gc_info(&info);
+  return info.used;
+}
 
 void MicroPython::registerScriptProvider(ScriptProvider *s) {
   sScriptProvider = s;
@@ -352,6 +376,74 @@ mp_lexer_t *mp_lexer_new_from_file(const char *filename) {
   }
 }
 
+struct BytecodeWriter {
+  char *buffer;
+  size_t capacity;
+  size_t size;
+};
+
+static void WriteBytecode(void *data, const char *str, size_t len) {
+  BytecodeWriter *writer = static_cast<BytecodeWriter *>(data);
+  if (writer->size + len <= writer->capacity) {
+    memcpy(writer->buffer + writer->size, str, len);
+  }
+  // An overflow is detected by the size exceeding the capacity
+  writer->size += len;
+}
+
+mp_raw_code_t *micropython_port_raw_code_from_file(const char *filename) {
+  const char *script = sScriptProvider != nullptr
+                           ? sScriptProvider->contentOfScript(filename, true)
+                           : nullptr;
+  if (script == nullptr) {
+    mp_raise_OSError(MP_ENOENT);
+  }
+
+  size_t bytecodeSize;
+  const void *bytecode =
+      sScriptProvider->compiledScript(filename, &bytecodeSize);
+  if (bytecode != nullptr) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+      mp_raw_code_t *rawCode = mp_raw_code_load_mem(
+          static_cast<const byte *>(bytecode), bytecodeSize);
+      nlr_pop();
+      return rawCode;
+    }
+    // The bytecode could not be loaded, compile the script again
+  }
+
+  mp_lexer_t *lex = mp_lexer_new_from_str_len(qstr_from_str(filename), script,
+                                              strlen(script), 0);
+  qstr sourceName = lex->source_name;
+  mp_parse_tree_t parseTree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+  mp_raw_code_t *rawCode =
+      mp_compile_to_raw_code(&parseTree, sourceName, false);
+
+  /* Keep the bytecode for the next imports. Native code is left out since it
+   * depends on where it was emitted. */
+  size_t capacity;
+  void *buffer = sScriptProvider->compiledScriptBuffer(filename, &capacity);
+  if (buffer != nullptr) {
+    BytecodeWriter writer = {static_cast<char *>(buffer), capacity, 0};
+    mp_print_t print = {&writer, WriteBytecode};
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+      mp_raw_code_save(rawCode, &print);
+      nlr_pop();
+    } else {
+      writer.size = 0;
+    }
+    if (writer.size > capacity ||
+        (writer.size > 2 &&
+         MPY_FEATURE_DECODE_ARCH(writer.buffer[2]) != MP_NATIVE_ARCH_NONE)) {
+      writer.size = 0;
+    }
+    sScriptProvider->compiledScriptWasWritten(filename, writer.size);
+  }
+  return rawCode;
+}
+
 mp_import_stat_t mp_import_stat(const char *path) {
   if (sScriptProvider && sScriptProvider->contentOfScript(path, false)) {
     return MP_IMPORT_STAT_FILE;
@@ -15,6 +15,20 @@ class ScriptProvider {
  public:
   virtual const char* contentOfScript(const char* name,
                                       bool markAsFetched) const = 0;
+  /* The bytecode of a script, as stored when it was last compiled, or nullptr
+   * if it was not kept or the script changed since. It is only a cache: the
+   * provider may drop it at any time. */
+  virtual const void* compiledScript(const char* name, size_t* size) const {
+    return nullptr;
+  }
+  /* To keep the bytecode of a script it just compiled, MicroPython writes it
+   * in a buffer lent by the provider, since the heap is too fragmented after
+   * a compilation to hold it. The buffer is given back with the size written,
+   * or 0 to drop it, before anything else happens. */
+  virtual void* compiledScriptBuffer(const char* name, size_t* capacity) const {
+    return nullptr;
+  }
+  virtual void compiledScriptWasWritten(const char* name, size_t size) const {}
 };
 
 class ExecutionEnvironment {
@@ -44,6 +58,9 @@ class ExecutionEnvironment {
 
 void init(void* heapStart, void* heapEnd);
 void deinit();
+bool isInitialized();
+// Bytes allocated on the heap
+size_t usedHeapSize();
 void registerScriptProvider(ScriptProvider* s);
 void collectRootsAtAddress(char* address, int len);
 
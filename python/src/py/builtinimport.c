@@ -129,7 +129,8 @@ STATIC mp_import_stat_t find_file(const char *file_str, uint file_len, vstr_t *d
     return stat_dir_or_file(dest);
 }
 
-#if MICROPY_MODULE_FROZEN_STR || MICROPY_ENABLE_COMPILER
+/* Warning: this is a NumWorks change to MicroPython 1.17 */
+#if MICROPY_MODULE_FROZEN_STR || (MICROPY_ENABLE_COMPILER && !defined(MICROPY_PORT_RAW_CODE_FROM_FILE))
 STATIC void do_load_from_lexer(mp_obj_t module_obj, mp_lexer_t *lex) {
     #if MICROPY_PY___FILE__
     qstr source_name = lex->source_name;
@@ -142,7 +143,8 @@ STATIC void do_load_from_lexer(mp_obj_t module_obj, mp_lexer_t *lex) {
 }
 #endif
 
-#if (MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD) || MICROPY_MODULE_FROZEN_MPY
+/* Warning: this is a NumWorks change to MicroPython 1.17 */
+#if (MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD) || MICROPY_MODULE_FROZEN_MPY || defined(MICROPY_PORT_RAW_CODE_FROM_FILE)
 STATIC void do_execute_raw_code(mp_obj_t module_obj, mp_raw_code_t *raw_code, const char *source_name) {
     (void)source_name;
 
@@ -221,11 +223,21 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
 
     // If we can compile scripts then load the file and compile and execute it.
     #if MICROPY_ENABLE_COMPILER
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    // The port may load the raw code from a cache instead of compiling it
+    #ifdef MICROPY_PORT_RAW_CODE_FROM_FILE
+    {
+        mp_raw_code_t *raw_code = MICROPY_PORT_RAW_CODE_FROM_FILE(file_str);
+        do_execute_raw_code(module_obj, raw_code, file_str);
+        return;
+    }
+    #else
     {
         mp_lexer_t *lex = mp_lexer_new_from_file(file_str);
         do_load_from_lexer(module_obj, lex);
         return;
     }
+    #endif
     #else
     // If we get here then the file was not frozen and we can't compile scripts.
     mp_raise_msg(&mp_type_ImportError, MP_ERROR_TEXT("script compilation not supported"));
@@ -2003,16 +2003,29 @@ STATIC void emit_native_rot_three(emit_t *emit) {
     emit_post_push_reg_reg_reg(emit, vtype0, REG_TEMP0, vtype2, REG_TEMP2, vtype1, REG_TEMP1);
 }
 
+/* Warning: this is a NumWorks change to MicroPython 1.17 */
+// Loops jump backwards: check there for a keyboard interrupt, as the VM does
+STATIC void emit_native_handle_pending_if_backward(emit_t *emit, mp_uint_t label) {
+    mp_asm_base_t *as = &emit->as->base;
+    if (as->label_offsets[label] != (size_t)-1 && as->label_offsets[label] <= as->code_offset) {
+        emit_call(emit, MP_F_NATIVE_HANDLE_PENDING);
+    }
+}
+
 STATIC void emit_native_jump(emit_t *emit, mp_uint_t label) {
     DEBUG_printf("jump(label=" UINT_FMT ")\n", label);
     emit_native_pre(emit);
     // need to commit stack because we are jumping elsewhere
     need_stack_settled(emit);
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    emit_native_handle_pending_if_backward(emit, label);
     ASM_JUMP(emit->as, label);
     emit_post(emit);
 }
 
 STATIC void emit_native_jump_helper(emit_t *emit, bool cond, mp_uint_t label, bool pop) {
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    emit_native_handle_pending_if_backward(emit, label);
     vtype_kind_t vtype = peek_vtype(emit, 0);
     if (vtype == VTYPE_PYOBJ) {
         emit_pre_pop_reg(emit, &vtype, REG_ARG_1);
@@ -251,6 +251,15 @@ STATIC double mp_obj_get_float_to_d(mp_obj_t o) {
 
 #endif
 
+/* Warning: this is a NumWorks change to MicroPython 1.17 */
+// Let the port interrupt native loops as it interrupts the bytecode ones
+STATIC void mp_native_handle_pending(void) {
+    #ifdef MICROPY_VM_HOOK_LOOP
+    MICROPY_VM_HOOK_LOOP
+    #endif
+    mp_handle_pending(true);
+}
+
 // these must correspond to the respective enum in nativeglue.h
 const mp_fun_table_t mp_fun_table = {
     mp_const_none,
@@ -321,7 +330,12 @@ const mp_fun_table_t mp_fun_table = {
     mp_obj_get_type,
     mp_obj_new_str,
     mp_obj_new_bytes,
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    #if MICROPY_PY_BUILTINS_BYTEARRAY
     mp_obj_new_bytearray_by_ref,
+    #else
+    NULL,
+    #endif
     mp_obj_new_float_from_f,
     mp_obj_new_float_from_d,
     mp_obj_get_float_to_f,
@@ -342,6 +356,8 @@ const mp_fun_table_t mp_fun_table = {
     &mp_stream_readinto_obj,
     &mp_stream_unbuffered_readline_obj,
     &mp_stream_write_obj,
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    mp_native_handle_pending,
 };
 
 #endif // MICROPY_EMIT_NATIVE
@@ -27,6 +27,7 @@
 #define MICROPY_INCLUDED_PY_NATIVEGLUE_H
 
 #include <stdarg.h>
+#include <stddef.h>
 #include "py/obj.h"
 #include "py/persistentcode.h"
 #include "py/stream.h"
@@ -170,8 +171,15 @@ typedef struct _mp_fun_table_t {
     const mp_obj_fun_builtin_var_t *stream_readinto_obj;
     const mp_obj_fun_builtin_var_t *stream_unbuffered_readline_obj;
     const mp_obj_fun_builtin_var_t *stream_write_obj;
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    // Appended after the dynamic runtime entries to keep their indices
+    void (*native_handle_pending)(void);
 } mp_fun_table_t;
 
+/* Warning: this is a NumWorks change to MicroPython 1.17 */
+#define MP_F_NATIVE_HANDLE_PENDING \
+    (offsetof(mp_fun_table_t, native_handle_pending) / sizeof(void *))
+
 extern const mp_fun_table_t mp_fun_table;
 
 #endif // MICROPY_INCLUDED_PY_NATIVEGLUE_H
@@ -286,6 +286,19 @@ STATIC mp_obj_t load_obj(mp_reader_t *reader) {
     byte obj_type = read_byte(reader);
     if (obj_type == 'e') {
         return MP_OBJ_FROM_PTR(&mp_const_ellipsis_obj);
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    #if MICROPY_PY_BUILTINS_FLOAT
+    } else if (obj_type == 'd') {
+        mp_float_t f;
+        read_bytes(reader, (byte *)&f, sizeof(f));
+        return mp_obj_new_float(f);
+    #if MICROPY_PY_BUILTINS_COMPLEX
+    } else if (obj_type == 'j') {
+        mp_float_t parts[2];
+        read_bytes(reader, (byte *)parts, sizeof(parts));
+        return mp_obj_new_complex(parts[0], parts[1]);
+    #endif
+    #endif
     } else {
         size_t len = read_uint(reader, NULL);
         vstr_t vstr;
@@ -642,6 +655,23 @@ STATIC void save_obj(mp_print_t *print, mp_obj_t o) {
     } else if (MP_OBJ_TO_PTR(o) == &mp_const_ellipsis_obj) {
         byte obj_type = 'e';
         mp_print_bytes(print, &obj_type, 1);
+    /* Warning: this is a NumWorks change to MicroPython 1.17 */
+    // Floats are saved exactly rather than as text, which may round them
+    #if MICROPY_PY_BUILTINS_FLOAT
+    } else if (mp_obj_is_float(o)) {
+        byte obj_type = 'd';
+        mp_float_t f = mp_obj_float_get(o);
+        mp_print_bytes(print, &obj_type, 1);
+        mp_print_bytes(print, (const byte *)&f, sizeof(f));
+    #if MICROPY_PY_BUILTINS_COMPLEX
+    } else if (mp_obj_is_type(o, &mp_type_complex)) {
+        byte obj_type = 'j';
+        mp_float_t parts[2];
+        mp_obj_complex_get(o, &parts[0], &parts[1]);
+        mp_print_bytes(print, &obj_type, 1);
+        mp_print_bytes(print, (const byte *)parts, sizeof(parts));
+    #endif
+    #endif
     } else {
         // we save numbers using a simplistic text representation
         // TODO could be improved
@@ -70,3 +70,34 @@ QUIZ_CASE(python_fixes) {
   deinit_environment();
 #endif
 }
+
+QUIZ_CASE(python_native_emitter) {
+#if PYTHON_NATIVE_EMITTER
+  assert_script_execution_succeeds(
+      "@micropython.native\n"
+      "def f(n):\n"
+      "  s = 0\n"
+      "  for i in range(n):\n"
+      "    s += i * i\n"
+      "  return s\n"
+      "print(f(1000))\n",
+      "332833500\n");
+  assert_script_execution_succeeds(
+      "@micropython.viper\n"
+      "def g(n: int) -> int:\n"
+      "  s = 0\n"
+      "  while n > 0:\n"
+      "    s += n\n"
+      "    n -= 1\n"
+      "  return s\n"
+      "print(g(1000))\n",
+      "500500\n");
+  // Native loops can be interrupted from the keyboard
+  TestExecutionEnvironment env = init_environement();
+  env.interrupt();
+  assert_command_execution_fails(
+      env,
+      "exec('@micropython.viper\\ndef h():\\n  while True:\\n    pass\\nh()')");
+  deinit_environment();
+#endif
+}
@@ -31,3 +31,39 @@ QUIZ_CASE(python_kandinsky_basics) {
   deinit_environment();
 #endif
 }
+
+QUIZ_CASE(python_kandinsky_bulk) {
+#ifndef PLATFORM_WINDOWS
+  TestExecutionEnvironment env = init_environement();
+  assert_command_execution_succeeds(env, "from kandinsky import *");
+  // RGB565 pixels: red then green
+  assert_command_execution_succeeds(
+      env, "set_pixels(0,0,2,1,b'\\x00\\xf8\\xe0\\x07')");
+  assert_command_execution_succeeds(env, "len(get_pixels(0,0,2,1))", "4\n");
+  assert_command_execution_fails(env, "set_pixels(0,0,2,2,b'\\x00\\xf8')");
+  assert_command_execution_fails(env, "set_pixels(0,0,-1,1,b'')");
+  assert_command_execution_fails(env, "get_pixels(0,0,65536,65536)");
+  assert_command_execution_fails(env, "get_pixels(0,0,1<<31,1<<31)");
+  assert_command_execution_fails(env, "get_pixels(32767,0,2,1)");
+  assert_command_execution_fails(env, "get_pixels(40000,0,1,1)");
+
+  // Numpy arrays of uint16
+  assert_command_execution_succeeds(env, "import numpy as np");
+  assert_command_execution_succeeds(
+      env, "set_pixels(0,1,2,1,np.array([31,31],dtype=np.uint16))");
+  assert_command_execution_succeeds(env, "a=np.zeros(2,dtype=np.uint16)");
+  assert_command_execution_succeeds(env, "get_pixels(0,1,2,1,a) is a",
+                                    "True\n");
+  assert_command_execution_fails(env, "get_pixels(0,1,4,1,a)");
+  assert_command_execution_fails(env, "set_pixels(0,1,2,1,np.array([1,2]))");
+
+  assert_command_execution_succeeds(env,
+                                    "draw_polyline([0,4,4],[2,2,4],'blue')");
+  assert_command_execution_succeeds(
+      env, "draw_polyline(np.array([0,4],dtype=np.int16),(2,2),'red')");
+  assert_command_execution_fails(env, "draw_polyline([0,4],[2],'blue')");
+  assert_command_execution_fails(env, "draw_polyline([0,40000],[2,2],'blue')");
+  assert_command_execution_fails(env, "draw_polyline([0,4.5],[2,2],'blue')");
+  deinit_environment();
+#endif
+}
@@ -20,6 +20,7 @@ extern "C" {
 void quiz_assert(bool condition);
 void quiz_print(const char* message);
 extern bool sSkipAssertions;
+extern int sNumberOfFailedAssertions;
 
 #ifdef __cplusplus
 }
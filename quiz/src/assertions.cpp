@@ -3,10 +3,12 @@
 #include <stdlib.h>
 
 bool sSkipAssertions = false;
+int sNumberOfFailedAssertions = 0;
 
 void quiz_assert(bool condition) {
   if (!condition) {
     quiz_print("  ASSERTION FAILED");
+    sNumberOfFailedAssertions++;
     if (sSkipAssertions) {
       return;
     }
@@ -9,68 +9,311 @@
 #include "quiz.h"
 #include "symbols.h"
 
+/* On host simulators, the runner can profile the quiz cases and split them
+ * between several forked workers. Forking rather than spawning threads keeps
+ * the cases isolated from each other's global state (storage, apps...). */
+#if !PLATFORM_DEVICE && !__EMSCRIPTEN__ && !_WIN32
+#define QUIZ_PROFILING 1
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#else
+#define QUIZ_PROFILING 0
+#endif
+
 void quiz_print(const char *message) { Ion::Console::writeLine(message); }
 
 bool quiz_print_clear() { return Ion::Console::clear(); }
 
-static inline void ion_main_inner(const char *testFilter) {
-  int i = 0;
+struct RunnerOptions {
+  const char *testFilter = nullptr;
+#if QUIZ_PROFILING
+  // Number of forked workers, the cases are run in this process if 0
+  int numberOfJobs = 0;
+  // Per-case report written as JSON
+  const char *reportPath = nullptr;
+  // Only run cases that took at least this time in a previous report
+  const char *timingsPath = nullptr;
+  int slowerThan = 0;
+#endif
+};
+
+struct CaseResult {
+  int caseIndex;
+  int duration;
+  int poolPeakSize;
+  int numberOfRaises;
+  int numberOfFailedAssertions;
+};
+
+#if QUIZ_PROFILING
+static int numberOfQuizCases() {
+  int n = 0;
+  while (quiz_cases[n] != NULL) {
+    n++;
+  }
+  return n;
+}
+
+/* Mark the cases that took at least minimalDuration in a report previously
+ * written by writeCaseResult. Cases missing from the report are skipped. */
+static bool selectSlowCases(const char *timingsPath, int minimalDuration,
+                            bool *selected) {
+  FILE *f = fopen(timingsPath, "r");
+  if (!f) {
+    return false;
+  }
+  int n = numberOfQuizCases();
+  constexpr int k_lineSize = 512;
+  char line[k_lineSize];
+  char name[k_lineSize];
+  int duration;
+  while (fgets(line, k_lineSize, f)) {
+    if (sscanf(line, " {\"name\": \"%511[^\"]\", \"duration_ms\": %d", name,
+               &duration) != 2 ||
+        duration < minimalDuration) {
+      continue;
+    }
+    for (int i = 0; i < n; i++) {
+      if (strcmp(quiz_case_names[i], name) == 0) {
+        selected[i] = true;
+        break;
+      }
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+static void writeCaseResult(FILE *report, const CaseResult &result,
+                            bool first) {
+  fprintf(report,
+          "%s\n    {\"name\": \"%s\", \"duration_ms\": %d, "
+          "\"pool_peak_bytes\": %d, \"checkpoint_raises\": %d, "
+          "\"failed_assertions\": %d}",
+          first ? "" : ",", quiz_case_names[result.caseIndex],
+          result.duration, result.poolPeakSize, result.numberOfRaises,
+          result.numberOfFailedAssertions);
+}
+#endif
+
+static bool caseIsSkipped(int i, const char *testFilter,
+                          const bool *selected) {
+#ifndef PLATFORM_DEVICE
+  if (testFilter &&
+      strstr(quiz_case_names[i], testFilter) != quiz_case_names[i]) {
+    return true;
+  }
+#endif
+  return selected && !selected[i];
+}
+
+static CaseResult runCase(int i) {
+  int initialPoolSize = Poincare::TreePool::sharedPool->numberOfNodes();
+  quiz_assert(initialPoolSize == 0);
+  int initialFailedAssertions = sNumberOfFailedAssertions;
+#if POINCARE_POOL_TELEMETRY
+  Poincare::TreePool::sharedPool->resetTelemetry();
+#endif
+  uint64_t startTime = Ion::Timing::millis();
+  quiz_cases[i]();
+  CaseResult result;
+  result.caseIndex = i;
+  result.duration = Ion::Timing::millis() - startTime;
+#if POINCARE_POOL_TELEMETRY
+  const Poincare::TreePool::Telemetry &telemetry =
+      Poincare::TreePool::sharedPool->telemetry();
+  result.poolPeakSize = telemetry.peakSize;
+  result.numberOfRaises = telemetry.numberOfRaises;
+#else
+  result.poolPeakSize = 0;
+  result.numberOfRaises = 0;
+#endif
+  int currentPoolSize = Poincare::TreePool::sharedPool->numberOfNodes();
+  quiz_assert(initialPoolSize == currentPoolSize);
+  result.numberOfFailedAssertions =
+      sNumberOfFailedAssertions - initialFailedAssertions;
+  return result;
+}
+
+#if QUIZ_PROFILING
+/* Deal the cases between the workers, each of them sending back its results
+ * through a pipe. A worker stops at the first failed assertion unless they are
+ * skipped: the case it was running is then reported as crashed. Return the
+ * number of cases that ran. */
+static int runCasesInWorkers(int numberOfJobs, const char *testFilter,
+                             const bool *selected, FILE *report) {
+  constexpr int k_bufferSize = 128;
+  char buffer[k_bufferSize];
+  int *pipes = static_cast<int *>(malloc(numberOfJobs * sizeof(int)));
+  pid_t *workers = static_cast<pid_t *>(malloc(numberOfJobs * sizeof(pid_t)));
+  fflush(stdout);
+  for (int job = 0; job < numberOfJobs; job++) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+      quiz_print("Could not create a pipe for the workers");
+      abort();
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fds[0]);
+      int caseIndex = 0;
+      for (int i = 0; quiz_cases[i] != NULL; i++) {
+        if (caseIsSkipped(i, testFilter, selected)) {
+          continue;
+        }
+        if (caseIndex++ % numberOfJobs == job) {
+          CaseResult result = runCase(i);
+          write(fds[1], &result, sizeof(CaseResult));
+        }
+      }
+      close(fds[1]);
+      fflush(stdout);
+      _exit(0);
+    }
+    close(fds[1]);
+    pipes[job] = fds[0];
+    workers[job] = pid;
+  }
+
+  int numberOfCases = 0;
+  int numberOfCrashedWorkers = 0;
+  for (int job = 0; job < numberOfJobs; job++) {
+    CaseResult result;
+    int lastCaseIndex = -1;
+    while (read(pipes[job], &result, sizeof(CaseResult)) ==
+           sizeof(CaseResult)) {
+      if (report) {
+        writeCaseResult(report, result, numberOfCases == 0);
+      }
+      if (result.numberOfFailedAssertions > 0) {
+        Poincare::Print::CustomPrintf(buffer, k_bufferSize, "FAILED: %s",
+                                      quiz_case_names[result.caseIndex]);
+        quiz_print(buffer);
+      }
+      lastCaseIndex = result.caseIndex;
+      numberOfCases++;
+    }
+    close(pipes[job]);
+    int status;
+    waitpid(workers[job], &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      // Find the case following the last one reported by this worker
+      int caseIndex = 0;
+      int crashedCase = -1;
+      for (int i = 0; quiz_cases[i] != NULL && crashedCase < 0; i++) {
+        if (caseIsSkipped(i, testFilter, selected)) {
+          continue;
+        }
+        if (caseIndex++ % numberOfJobs == job && i > lastCaseIndex) {
+          crashedCase = i;
+        }
+      }
+      Poincare::Print::CustomPrintf(
+          buffer, k_bufferSize, "CRASHED: %s",
+          crashedCase < 0 ? "?" : quiz_case_names[crashedCase]);
+      quiz_print(buffer);
+      numberOfCrashedWorkers++;
+    }
+  }
+  free(pipes);
+  free(workers);
+  quiz_assert(numberOfCrashedWorkers == 0);
+  return numberOfCases;
+}
+#endif
+
+static inline void ion_main_inner(const RunnerOptions &options) {
+  const char *testFilter = options.testFilter;
+  const bool *selected = nullptr;
   int time = Ion::Timing::millis();
   int totalCases = 0;
 
-  // First pass to count the number of quiz cases
-  while (quiz_cases[i] != NULL) {
-#ifndef PLATFORM_DEVICE
-    if (testFilter &&
-        strstr(quiz_case_names[i], testFilter) != quiz_case_names[i]) {
-      i++;
-      continue;
+#if QUIZ_PROFILING
+  bool *slowCases = nullptr;
+  if (options.timingsPath) {
+    slowCases = static_cast<bool *>(calloc(numberOfQuizCases(), sizeof(bool)));
+    if (!selectSlowCases(options.timingsPath, options.slowerThan, slowCases)) {
+      quiz_print("Could not read the timings file");
+      abort();
+    }
+    selected = slowCases;
+  }
+  FILE *report = nullptr;
+  if (options.reportPath) {
+    report = fopen(options.reportPath, "w");
+    if (!report) {
+      quiz_print("Could not open the report file");
+      abort();
     }
+    fprintf(report, "{\n  \"cases\": [");
+  }
 #endif
-    i++;
-    totalCases++;
+
+  // First pass to count the number of quiz cases
+  for (int i = 0; quiz_cases[i] != NULL; i++) {
+    if (!caseIsSkipped(i, testFilter, selected)) {
+      totalCases++;
+    }
   }
 
-  // Second pass to test quiz cases
   constexpr int k_bufferSize = 30;
   char buffer[k_bufferSize];
-  i = 0;
   int caseIndex = 0;
-  while (quiz_cases[i] != NULL) {
-#ifndef PLATFORM_DEVICE
-    if (testFilter &&
-        strstr(quiz_case_names[i], testFilter) != quiz_case_names[i]) {
-      i++;
-      continue;
-    }
+#if QUIZ_PROFILING
+  if (options.numberOfJobs > 0) {
+    caseIndex = runCasesInWorkers(options.numberOfJobs, testFilter, selected,
+                                  report);
+  } else
+#endif
+  {
+    // Second pass to test quiz cases
+    for (int i = 0; quiz_cases[i] != NULL; i++) {
+      if (caseIsSkipped(i, testFilter, selected)) {
+        continue;
+      }
+      caseIndex++;
+      if (quiz_print_clear()) {
+        // Avoid cluttering the display if it can't be cleared
+        Poincare::Print::CustomPrintf(buffer, k_bufferSize, "TEST: %i/%i",
+                                      caseIndex, totalCases);
+        quiz_print(buffer);
+      }
+      quiz_print(quiz_case_names[i]);
+      CaseResult result = runCase(i);
+#if QUIZ_PROFILING
+      if (report) {
+        writeCaseResult(report, result, caseIndex == 1);
+      }
+#else
+      (void)result;
 #endif
-    caseIndex++;
-    QuizCase c = quiz_cases[i];
-    if (quiz_print_clear()) {
-      // Avoid cluttering the display if it can't be cleared
-      Poincare::Print::CustomPrintf(buffer, k_bufferSize, "TEST: %i/%i",
-                                    caseIndex, totalCases);
-      quiz_print(buffer);
     }
-    quiz_print(quiz_case_names[i]);
-    int initialPoolSize = Poincare::TreePool::sharedPool->numberOfNodes();
-    quiz_assert(initialPoolSize == 0);
-    c();
-    int currentPoolSize = Poincare::TreePool::sharedPool->numberOfNodes();
-    quiz_assert(initialPoolSize == currentPoolSize);
-    i++;
+    quiz_print_clear();
   }
-  quiz_print_clear();
 
   // Display test results
-  Poincare::Print::CustomPrintf(buffer, k_bufferSize, "ALL %i TESTS FINISHED",
-                                caseIndex);
+  if (caseIndex == totalCases) {
+    Poincare::Print::CustomPrintf(buffer, k_bufferSize,
+                                  "ALL %i TESTS FINISHED", caseIndex);
+  } else {
+    Poincare::Print::CustomPrintf(buffer, k_bufferSize, "%i/%i TESTS FINISHED",
+                                  caseIndex, totalCases);
+  }
   quiz_print(buffer);
 
   // Display test duration
   time = Ion::Timing::millis() - time;
   Poincare::Print::CustomPrintf(buffer, k_bufferSize, "DURATION: %i ms", time);
   quiz_print(buffer);
+#if QUIZ_PROFILING
+  if (report) {
+    fprintf(report, "\n  ],\n  \"duration_ms\": %d\n}\n", time);
+    fclose(report);
+  }
+  free(slowCases);
+#endif
 #ifdef PLATFORM_DEVICE
   while (1) {
     Ion::Timing::msleep(100000);
@@ -83,17 +326,30 @@ void ion_main(int argc, const char *const argv[]) {
   Escher::Init();
   Apps::Init();
 
-  const char *testFilter = nullptr;
+  RunnerOptions options;
   sSkipAssertions = false;
 #if !PLATFORM_DEVICE
   for (int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "--filter") == 0 || strcmp(argv[i], "-f") == 0) {
       assert(i + 1 < argc);
-      testFilter = argv[i + 1];
+      options.testFilter = argv[i + 1];
     } else if (strcmp(argv[i], "--skip-assertions") == 0 ||
                strcmp(argv[i], "-s") == 0) {
       sSkipAssertions = true;
     }
+#if QUIZ_PROFILING
+    else if (strcmp(argv[i], "--jobs") == 0 || strcmp(argv[i], "-j") == 0) {
+      assert(i + 1 < argc);
+      options.numberOfJobs = atoi(argv[i + 1]);
+    } else if (strcmp(argv[i], "--report") == 0) {
+      assert(i + 1 < argc);
+      options.reportPath = argv[i + 1];
+    } else if (strcmp(argv[i], "--slower-than") == 0) {
+      assert(i + 2 < argc);
+      options.slowerThan = atoi(argv[i + 1]);
+      options.timingsPath = argv[i + 2];
+    }
+#endif
   }
 #endif
   /* s_stackStart must be defined as early as possible to ensure that there
@@ -104,7 +360,7 @@ void ion_main(int argc, const char *const argv[]) {
   Ion::setStackStart((void *)(&stackTop));
   Poincare::ExceptionCheckpoint ecp;
   if (ExceptionRun(ecp)) {
-    ion_main_inner(testFilter);
+    ion_main_inner(options);
   } else {
     // There has been a memory allocation problem
 #if POINCARE_TREE_LOG